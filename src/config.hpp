@@ -10,18 +10,195 @@
 
 using namespace Config::Values;
 
+// Every option of the plugin: value class, type, key (under plugin:hyprtasking:), field of
+// HTConfig::HTOptions, description and default. init_config registers them from this list.
+#define HT_CONFIG_OPTIONS(OPTION) \
+    OPTION(CStringValue, STRING, "layout", layout, "layout", "grid") \
+    /* general */ \
+    OPTION(CIntValue, INTEGER, "bg_color", bg_color, "background color", 0x000000FF) \
+    OPTION(CFloatValue, FLOAT, "gap_size", gap_size, "gap size", 8.f) \
+    OPTION(CFloatValue, FLOAT, "border_size", border_size, "border size", 4.f) \
+    OPTION(CIntValue, INTEGER, "exit_on_hovered", exit_on_hovered, "exit on hovered", 0) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "warp_on_move_window", \
+        warp_on_move_window, \
+        "warp on move window", \
+        1 \
+    ) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "close_overview_on_reload", \
+        close_overview_on_reload, \
+        "close overview on reload", \
+        1 \
+    ) \
+    OPTION(CIntValue, INTEGER, "drag_button", drag_button, "drag button", BTN_LEFT) \
+    OPTION(CIntValue, INTEGER, "select_button", select_button, "select button", BTN_RIGHT) \
+    /* keyboard workspace jump labels */ \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "jump:enabled", \
+        jump.enabled, \
+        "enable keyboard workspace jump labels", \
+        0 \
+    ) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "jump:label_color", \
+        jump.label_color, \
+        "jump label color", \
+        0xFFFFFFFF \
+    ) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "jump:label_background", \
+        jump.label_background, \
+        "jump label background", \
+        0x000000CC \
+    ) \
+    OPTION(CIntValue, INTEGER, "jump:label_size", jump.label_size, "jump label font size", 32) \
+    /* swipe */ \
+    OPTION(CIntValue, INTEGER, "gestures:enabled", gestures.enabled, "enabled", 1) \
+    OPTION(CIntValue, INTEGER, "gestures:move_fingers", gestures.move_fingers, "move fingers", 3) \
+    OPTION( \
+        CFloatValue, \
+        FLOAT, \
+        "gestures:move_distance", \
+        gestures.move_distance, \
+        "move distance", \
+        300.0 \
+    ) \
+    OPTION(CIntValue, INTEGER, "gestures:open_fingers", gestures.open_fingers, "open fingers", 4) \
+    OPTION( \
+        CFloatValue, \
+        FLOAT, \
+        "gestures:open_distance", \
+        gestures.open_distance, \
+        "open distance", \
+        300.0 \
+    ) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "gestures:open_positive", \
+        gestures.open_positive, \
+        "open positive", \
+        1 \
+    ) \
+    /* grid specific */ \
+    OPTION(CIntValue, INTEGER, "grid:rows", grid.rows, "rows", 3) \
+    OPTION(CIntValue, INTEGER, "grid:cols", grid.cols, "cols", 3) \
+    OPTION(CIntValue, INTEGER, "grid:layers", grid.layers, "layers", 1) \
+    OPTION(CIntValue, INTEGER, "grid:loop_layers", grid.loop_layers, "loop layers", 1) \
+    OPTION(CIntValue, INTEGER, "grid:loop", grid.loop, "loop", 0) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "grid:gaps_use_aspect_ratio", \
+        grid.gaps_use_aspect_ratio, \
+        "gaps use aspect ratio", \
+        0 \
+    ) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "grid:inactive_refresh_interval", \
+        grid.inactive_refresh_interval, \
+        "inactive tile refresh interval (ms)", \
+        0 \
+    ) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "grid:inactive_tiles_per_frame", \
+        grid.inactive_tiles_per_frame, \
+        "inactive tile refreshes per frame", \
+        0 \
+    ) \
+    OPTION( \
+        CIntValue, \
+        INTEGER, \
+        "grid:thumbnail_lod", \
+        grid.thumbnail_lod, \
+        "render inactive tiles at tile size", \
+        0 \
+    ) \
+    /* linear specific */ \
+    OPTION(CIntValue, INTEGER, "linear:blur", linear.blur, "blur", 1) \
+    OPTION(CFloatValue, FLOAT, "linear:height", linear.height, "height", 300.f) \
+    OPTION(CFloatValue, FLOAT, "linear:scroll_speed", linear.scroll_speed, "scroll speed", 1.f) \
+    OPTION(CIntValue, INTEGER, "linear:top", linear.top, "top", 0)
+
 namespace HTConfig {
 
-template<typename T>
-inline T value(std::string config) {
-    static std::unordered_map<std::string, CConfigValue<T>> cache;
+// Plain copy of every option. Read through options(), which costs a field load.
+struct HTOptions {
+    Config::STRING layout;
+
+    Config::INTEGER bg_color;
+    Config::FLOAT gap_size;
+    Config::FLOAT border_size;
+    Config::INTEGER exit_on_hovered;
+    Config::INTEGER warp_on_move_window;
+    Config::INTEGER close_overview_on_reload;
+    Config::INTEGER drag_button;
+    Config::INTEGER select_button;
+
+    struct {
+        Config::INTEGER enabled;
+        Config::INTEGER label_color;
+        Config::INTEGER label_background;
+        Config::INTEGER label_size;
+    } jump;
+
+    struct {
+        Config::INTEGER enabled;
+        Config::INTEGER move_fingers;
+        Config::FLOAT move_distance;
+        Config::INTEGER open_fingers;
+        Config::FLOAT open_distance;
+        Config::INTEGER open_positive;
+    } gestures;
 
-    if (!cache.count(config)) {
-        const CConfigValue<T> val("plugin:hyprtasking:" + config);
-        cache[config] = val;
-    }
+    struct {
+        Config::INTEGER rows;
+        Config::INTEGER cols;
+        Config::INTEGER layers;
+        Config::INTEGER loop_layers;
+        Config::INTEGER loop;
+        Config::INTEGER gaps_use_aspect_ratio;
+        Config::INTEGER inactive_refresh_interval;
+        Config::INTEGER inactive_tiles_per_frame;
+        Config::INTEGER thumbnail_lod;
+    } grid;
+
+    struct {
+        Config::INTEGER blur;
+        Config::FLOAT height;
+        Config::FLOAT scroll_speed;
+        Config::INTEGER top;
+    } linear;
+};
+
+inline HTOptions cached_options;
+
+inline const HTOptions& options() {
+    return cached_options;
+}
 
-    return *cache[config];
+// Copy the current value of every option. Call once the options are registered, and on every
+// config reload before anything reads them.
+inline void refresh() {
+#define HT_REFRESH_OPTION(VALUE_CLASS, TYPE, KEY, FIELD, DESCR, DEFAULT) \
+    cached_options.FIELD = *CConfigValue<Config::TYPE>("plugin:hyprtasking:" KEY);
+    HT_CONFIG_OPTIONS(HT_REFRESH_OPTION)
+#undef HT_REFRESH_OPTION
 }
 
 } // namespace HTConfig
@@ -8,6 +8,7 @@
 #include <hyprland/src/layout/LayoutManager.hpp>
 #include <hyprland/src/pointer/PointerManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
+#include <hyprland/src/render/Renderer.hpp>
 #include <hyprland/src/state/MonitorState.hpp>
 #include <hyprland/src/state/WorkspaceState.hpp>
 
@@ -78,6 +79,10 @@ bool HTManager::start_window_drag() {
     // if (o_workspace != nullptr)
     //     cursor_monitor->changeWorkspace(o_workspace.lock(), true);
 
+    // Drawn from this snapshot until the window commits new content. Captured in
+    // on_render_pre, as this handler runs outside the render pass.
+    drag_snapshot.request(dragged_window);
+    damage_drag();
     return true;
 }
 
@@ -178,6 +183,10 @@ bool HTManager::end_window_drag() {
     // if (o_workspace != nullptr)
     //     cursor_monitor->changeWorkspace(o_workspace.lock(), true);
 
+    // Clear the last drawn position of the dragged window
+    damage_drag();
+    drag_snapshot.clear();
+
     // Do not return true and cancel the event! Mouse release requires some stuff to be done for
     // floating windows to be unfocused properly
     return false;
@@ -203,7 +212,7 @@ bool HTManager::on_key(IKeyboard::SKeyEvent event) {
     if (event.state == WL_KEYBOARD_KEY_STATE_RELEASED && jump_pressed_keys.erase(event.keycode) > 0)
         return true;
 
-    if (!HTConfig::value<Config::INTEGER>("jump:enabled"))
+    if (!HTConfig::options().jump.enabled)
         return false;
 
     const PHTVIEW cursor_view = get_view_from_cursor();
@@ -270,6 +279,11 @@ bool HTManager::on_key(IKeyboard::SKeyEvent event) {
 }
 
 bool HTManager::on_mouse_move() {
+    // The dragged window follows the cursor, so only its old and new rect need redrawing. A
+    // leftover rect from a drag that just ended is cleared once.
+    if (g_layoutManager->dragController()->target() == nullptr && last_drag_box.empty())
+        return false;
+    damage_drag();
     return false;
 }
 
@@ -293,14 +307,14 @@ bool HTManager::swipe_update(IPointer::SSwipeUpdateEvent e) {
     if (cursor_view == nullptr)
         return false;
 
-    const int ENABLED = HTConfig::value<Config::INTEGER>("gestures:enabled");
+    const int ENABLED = HTConfig::options().gestures.enabled;
     if (!ENABLED)
         return false;
 
-    const unsigned int MOVE_FINGERS = HTConfig::value<Config::INTEGER>("gestures:move_fingers");
-    const float OPEN_DISTANCE = HTConfig::value<Config::FLOAT>("gestures:open_distance");
-    const unsigned int OPEN_FINGERS = HTConfig::value<Config::INTEGER>("gestures:open_fingers");
-    const int OPEN_POSITIVE = HTConfig::value<Config::INTEGER>("gestures:open_positive");
+    const unsigned int MOVE_FINGERS = HTConfig::options().gestures.move_fingers;
+    const float OPEN_DISTANCE = HTConfig::options().gestures.open_distance;
+    const unsigned int OPEN_FINGERS = HTConfig::options().gestures.open_fingers;
+    const int OPEN_POSITIVE = HTConfig::options().gestures.open_positive;
 
     bool res = false;
     char swipe_direction = 0;
@@ -334,6 +348,8 @@ bool HTManager::swipe_update(IPointer::SSwipeUpdateEvent e) {
             swipe_amt += deltaY;
             const float swipe_perc = 1.0 - std::clamp(swipe_amt / OPEN_DISTANCE, 0.01f, 1.0f);
             cursor_view->layout->close_open_lerp(swipe_perc);
+            // lerping warps the animations, which doesn't damage anything by itself
+            g_pHyprRenderer->damageMonitor(cursor_monitor);
         }
     } else if (e.fingers == MOVE_FINGERS) {
         if (swipe_state == HT_SWIPE_MOVE)
@@ -355,6 +371,7 @@ bool HTManager::swipe_update(IPointer::SSwipeUpdateEvent e) {
 
         if (swipe_state == HT_SWIPE_MOVE) {
             cursor_view->layout->on_move_swipe(e.delta);
+            g_pHyprRenderer->damageMonitor(cursor_monitor);
         }
     }
     return res;
@@ -367,7 +384,7 @@ bool HTManager::swipe_end() {
 
     switch (swipe_state) {
         case HT_SWIPE_OPEN: {
-            const float OPEN_DISTANCE = HTConfig::value<Config::FLOAT>("gestures:open_distance");
+            const float OPEN_DISTANCE = HTConfig::options().gestures.open_distance;
             const float swipe_perc = 1.0 - std::clamp(swipe_amt / OPEN_DISTANCE, 0.01f, 1.0f);
             if (swipe_perc >= 0.5) {
                 cursor_view->show(false);
@@ -1,6 +1,7 @@
 #include "grid.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <unordered_set>
 
 #include <hyprland/src/Compositor.hpp>
@@ -11,13 +12,13 @@
 #include <hyprland/src/animation/AnimationManager.hpp>
 #include <hyprland/src/animation/WorkspaceAnimationController.hpp>
 #include <hyprland/src/config/shared/animation/AnimationTree.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopTimer.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
 #include <hyprland/src/config/shared/workspace/WorkspaceRuleManager.hpp>
 #include <hyprland/src/layout/LayoutManager.hpp>
 #include <hyprland/src/render/OpenGL.hpp>
 #include <hyprland/src/render/Renderer.hpp>
-#include <hyprland/src/render/pass/BorderPassElement.hpp>
-#include <hyprland/src/render/pass/RectPassElement.hpp>
 #include <hyprland/src/state/WorkspaceState.hpp>
 #include <hyprutils/math/Vector2D.hpp>
 #include <hyprutils/utils/ScopeGuard.hpp>
@@ -25,6 +26,7 @@
 #include "../config.hpp"
 #include "../globals.hpp"
 #include "../overview.hpp"
+#include "../pass/pass_element.hpp"
 #include "../render.hpp"
 #include "../types.hpp"
 #include "src/layout/target/Target.hpp"
@@ -46,21 +48,77 @@ HTLayoutGrid::HTLayoutGrid(VIEWID new_view_id) : HTLayoutBase(new_view_id) {
         AVARDAMAGE_NONE
     );
 
+    // Fires when a damaged tile held back by grid:inactive_refresh_interval becomes due.
+    refresh_timer = makeShared<CEventLoopTimer>(
+        std::nullopt,
+        [this](SP<CEventLoopTimer> self, void* data) { damage_stale_tiles(); },
+        nullptr
+    );
+    g_pEventLoopManager->addTimer(refresh_timer);
+
     refresh_workspace_cache();
     init_position();
 }
 
-// Bit layout: [layer:24][y:20][x:20]. Used purely as an unordered_map key;
-// limits are implicit and not enforced (grid dims are not validated).
-long long HTLayoutGrid::pack_slot(int layer, int x, int y) {
-    return ((long long)layer << 40) | ((long long)(uint32_t)y << 20) | (long long)(uint32_t)x;
+HTLayoutGrid::~HTLayoutGrid() {
+    if (refresh_timer != nullptr)
+        g_pEventLoopManager->removeTimer(refresh_timer);
+}
+
+long long HTLayoutGrid::slot_index(int layer, int x, int y) const {
+    if (layer < 0 || layer >= table_layers || y < 0 || y >= table_rows || x < 0
+        || x >= table_cols)
+        return -1;
+    return ((long long)layer * table_rows + y) * table_cols + x;
 }
 
 WORKSPACEID HTLayoutGrid::slot_workspace(int layer, int x, int y) {
-    const auto it = slot_ws_cache.find(pack_slot(layer, x, y));
-    if (it == slot_ws_cache.end())
+    const long long idx = slot_index(layer, x, y);
+    if (idx < 0)
         return WORKSPACE_INVALID;
-    return it->second;
+    return slot_ws_table[(size_t)idx];
+}
+
+HTGridSlot HTLayoutGrid::slot_at(size_t idx) const {
+    const size_t per_layer = (size_t)table_rows * table_cols;
+    const size_t in_layer = idx % per_layer;
+    return HTGridSlot {
+        (int)(idx / per_layer),
+        (int)(in_layer % table_cols),
+        (int)(in_layer / table_cols)
+    };
+}
+
+bool HTLayoutGrid::slot_reserved(size_t idx) const {
+    return (reserved_slots[idx / 64] >> (idx % 64)) & 1;
+}
+
+void HTLayoutGrid::set_slot_reserved(size_t idx, bool reserved) {
+    if (reserved)
+        reserved_slots[idx / 64] |= uint64_t {1} << (idx % 64);
+    else
+        reserved_slots[idx / 64] &= ~(uint64_t {1} << (idx % 64));
+}
+
+long long HTLayoutGrid::next_free_slot(size_t from) const {
+    const size_t slot_count = slot_ws_table.size();
+    for (size_t word = from / 64; word < reserved_slots.size(); word++) {
+        uint64_t free = ~reserved_slots[word];
+        // Skip the bits before `from` in its own word
+        if (word == from / 64)
+            free &= ~uint64_t {0} << (from % 64);
+        if (free == 0)
+            continue;
+        const size_t idx = word * 64 + std::countr_zero(free);
+        return idx < slot_count ? (long long)idx : -1;
+    }
+    return -1;
+}
+
+void HTLayoutGrid::place_workspace(WORKSPACEID id, size_t idx, bool reserve) {
+    ws_slot_cache[id] = slot_at(idx);
+    slot_ws_table[idx] = id;
+    set_slot_reserved(idx, reserve);
 }
 
 void HTLayoutGrid::refresh_workspace_cache(
@@ -70,63 +128,45 @@ void HTLayoutGrid::refresh_workspace_cache(
     if (monitor == nullptr)
         return;
 
-    const int ROWS = HTConfig::value<Config::INTEGER>("grid:rows");
-    const int COLS = HTConfig::value<Config::INTEGER>("grid:cols");
-    const int LAYERS = HTConfig::value<Config::INTEGER>("grid:layers");
+    const int ROWS = HTConfig::options().grid.rows;
+    const int COLS = HTConfig::options().grid.cols;
+    const int LAYERS = HTConfig::options().grid.layers;
     if (ROWS <= 0 || COLS <= 0 || LAYERS <= 0)
         return;
 
-    const auto prior = ws_slot_cache;
-
-    ws_slot_cache.clear();
-    slot_ws_cache.clear();
+    std::unordered_map<WORKSPACEID, HTGridSlot> prior;
+    prior.swap(ws_slot_cache);
+    bound_workspaces.clear();
 
-    std::vector<HTGridSlot> slots;
-    slots.reserve((size_t)LAYERS * ROWS * COLS);
-    for (int l = 0; l < LAYERS; l++)
-        for (int y = 0; y < ROWS; y++)
-            for (int x = 0; x < COLS; x++)
-                slots.push_back(HTGridSlot {l, x, y});
+    table_layers = LAYERS;
+    table_rows = ROWS;
+    table_cols = COLS;
+    const size_t slot_count = (size_t)LAYERS * ROWS * COLS;
+    slot_ws_table.assign(slot_count, WORKSPACE_INVALID);
+    reserved_slots.assign((slot_count + 63) / 64, 0);
+    invalidate_overview_layout();
 
-    std::vector<bool> taken(slots.size(), false);
-
-    auto place = [&](WORKSPACEID id, size_t slot_idx) {
-        const HTGridSlot& s = slots[slot_idx];
-        ws_slot_cache[id] = s;
-        slot_ws_cache[pack_slot(s.layer, s.x, s.y)] = id;
-        taken[slot_idx] = true;
-    };
-
-    auto find_slot_index = [&](const HTGridSlot& s) -> long long {
-        for (size_t i = 0; i < slots.size(); i++)
-            if (slots[i].layer == s.layer && slots[i].x == s.x && slots[i].y == s.y)
-                return (long long)i;
-        return -1;
-    };
-
-    auto next_free_slot = [&](size_t& cursor) -> long long {
-        while (cursor < slots.size() && taken[cursor])
-            cursor++;
-        if (cursor >= slots.size())
+    // A prior slot still fits if it lies inside the new table and nobody took it yet
+    auto free_prior_slot = [&](WORKSPACEID id) -> long long {
+        const auto pit = prior.find(id);
+        if (pit == prior.end())
             return -1;
-        return (long long)cursor;
+        const long long idx = slot_index(pit->second.layer, pit->second.x, pit->second.y);
+        return idx >= 0 && !slot_reserved((size_t)idx) ? idx : -1;
     };
 
-    auto place_with_prior = [&](WORKSPACEID id, size_t& cursor) -> bool {
+    size_t cursor = 0;
+    auto place_with_prior = [&](WORKSPACEID id) -> bool {
         if (ws_slot_cache.count(id))
             return false;
-        const auto pit = prior.find(id);
-        if (pit != prior.end()) {
-            const long long idx = find_slot_index(pit->second);
-            if (idx >= 0 && !taken[(size_t)idx]) {
-                place(id, (size_t)idx);
-                return true;
-            }
+        long long idx = free_prior_slot(id);
+        if (idx < 0) {
+            idx = next_free_slot(cursor);
+            if (idx < 0)
+                return false;
+            cursor = (size_t)idx;
         }
-        const long long idx = next_free_slot(cursor);
-        if (idx < 0)
-            return false;
-        place(id, (size_t)idx);
+        place_workspace(id, (size_t)idx, true);
         return true;
     };
 
@@ -147,8 +187,6 @@ void HTLayoutGrid::refresh_workspace_cache(
             off_limits.insert(w->m_id);
     }
 
-    size_t cursor = 0;
-
     // Sort by workspaceId so slot assignment doesn't depend on config-line order.
     std::vector<SP<Config::CWorkspaceRule>> rules_sorted;
     rules_sorted.reserve(all_rules.size());
@@ -171,45 +209,38 @@ void HTLayoutGrid::refresh_workspace_cache(
         );
         if (bound == nullptr || bound->m_id != view_id)
             continue;
-        place_with_prior(rule->m_workspaceId, cursor);
+        if (place_with_prior(rule->m_workspaceId))
+            bound_workspaces.insert(rule->m_workspaceId);
     }
 
-    // Sort by m_id so slot assignment is independent of Hyprland's internal
+    // Sorted by id so slot assignment is independent of Hyprland's internal
     // m_workspaces vector order.
-    std::vector<PHLWORKSPACE> on_monitor;
-    for (const auto& w : State::workspaceState()->workspacesCopy()) {
-        if (w == nullptr)
-            continue;
-        if (w->monitorID() != view_id)
-            continue;
-        if (w->m_id <= 0)
+    std::vector<WORKSPACEID> on_monitor;
+    for (const WORKSPACEID id : ht_manager->monitor_workspaces(view_id)) {
+        if (id <= 0)
             continue;
-        if (extra_off_limits.count(w->m_id))
+        if (extra_off_limits.count(id))
             continue;
-        on_monitor.push_back(w);
+        on_monitor.push_back(id);
     }
-    std::sort(on_monitor.begin(), on_monitor.end(),
-              [](const PHLWORKSPACE& a, const PHLWORKSPACE& b) {
-                  return a->m_id < b->m_id;
-              });
     // Settle workspaces that still have a free prior slot before assigning
     // anyone via the cursor — otherwise a migrated workspace with no prior
     // here would steal slot 0 and displace this monitor's resident at (0,0).
-    std::vector<PHLWORKSPACE> needs_cursor;
-    for (const auto& w : on_monitor) {
-        const auto pit = prior.find(w->m_id);
-        if (pit != prior.end()) {
-            const long long idx = find_slot_index(pit->second);
-            if (idx >= 0 && !taken[(size_t)idx]) {
-                place(w->m_id, (size_t)idx);
-                continue;
-            }
+    std::vector<WORKSPACEID> needs_cursor;
+    for (const WORKSPACEID id : on_monitor) {
+        if (ws_slot_cache.count(id))
+            continue;
+        const long long idx = free_prior_slot(id);
+        if (idx >= 0) {
+            place_workspace(id, (size_t)idx, true);
+            continue;
         }
-        needs_cursor.push_back(w);
+        needs_cursor.push_back(id);
     }
-    for (const auto& w : needs_cursor)
-        place_with_prior(w->m_id, cursor);
+    for (const WORKSPACEID id : needs_cursor)
+        place_with_prior(id);
 
+    // The remaining slots get placeholder ids, and stay free for new workspaces
     WORKSPACEID synth_candidate = 1;
     auto next_synth = [&]() -> WORKSPACEID {
         while (true) {
@@ -221,12 +252,57 @@ void HTLayoutGrid::refresh_workspace_cache(
         }
     };
 
-    for (size_t i = 0; i < slots.size(); i++) {
-        if (taken[i])
-            continue;
-        const WORKSPACEID id = next_synth();
-        place(id, i);
+    for (long long idx = next_free_slot(0); idx >= 0; idx = next_free_slot((size_t)idx + 1))
+        place_workspace(next_synth(), (size_t)idx, false);
+}
+
+void HTLayoutGrid::add_workspace(WORKSPACEID id) {
+    if (id <= 0 || slot_ws_table.empty())
+        return;
+
+    const auto it = ws_slot_cache.find(id);
+    if (it != ws_slot_cache.end()) {
+        // Its placeholder slot becomes a real one
+        const long long idx = slot_index(it->second.layer, it->second.x, it->second.y);
+        if (idx >= 0)
+            set_slot_reserved((size_t)idx, true);
+        return;
     }
+
+    // Like a full refresh, a workspace that doesn't fit is left out of the grid
+    const long long idx = next_free_slot(0);
+    if (idx < 0)
+        return;
+    ws_slot_cache.erase(slot_ws_table[(size_t)idx]);
+    place_workspace(id, (size_t)idx, true);
+    invalidate_overview_layout();
+}
+
+bool HTLayoutGrid::remove_workspace(WORKSPACEID id, bool moved) {
+    const auto it = ws_slot_cache.find(id);
+    if (it == ws_slot_cache.end())
+        return true;
+    const long long idx = slot_index(it->second.layer, it->second.x, it->second.y);
+    if (idx < 0)
+        return false;
+
+    if (!moved) {
+        // The id stays on its slot as a placeholder, so the slot is sticky for the workspace.
+        // Rule-bound workspaces keep theirs reserved.
+        if (!bound_workspaces.contains(id))
+            set_slot_reserved((size_t)idx, false);
+        return true;
+    }
+
+    // The id now lives on another monitor, so the slot needs a fresh placeholder
+    WORKSPACEID placeholder = 1;
+    while (ht_manager->workspace_id_claimed(placeholder))
+        placeholder++;
+    ws_slot_cache.erase(it);
+    bound_workspaces.erase(id);
+    place_workspace(placeholder, (size_t)idx, false);
+    invalidate_overview_layout();
+    return true;
 }
 
 std::string HTLayoutGrid::layout_name() {
@@ -234,9 +310,9 @@ std::string HTLayoutGrid::layout_name() {
 }
 
 WORKSPACEID HTLayoutGrid::get_ws_id_in_direction(int x, int y, std::string& direction) {
-    const int LOOP = HTConfig::value<Config::INTEGER>("grid:loop");
-    const int ROWS = HTConfig::value<Config::INTEGER>("grid:rows");
-    const int COLS = HTConfig::value<Config::INTEGER>("grid:cols");
+    const int LOOP = HTConfig::options().grid.loop;
+    const int ROWS = HTConfig::options().grid.rows;
+    const int COLS = HTConfig::options().grid.cols;
 
     if (direction == "up") {
         y--;
@@ -262,9 +338,9 @@ void HTLayoutGrid::on_move_swipe(Vector2D delta) {
     if (monitor == nullptr)
         return;
 
-    const float MOVE_DISTANCE = HTConfig::value<Config::FLOAT>("gestures:move_distance");
-    const int ROWS = HTConfig::value<Config::INTEGER>("grid:rows");
-    const int COLS = HTConfig::value<Config::INTEGER>("grid:cols");
+    const float MOVE_DISTANCE = HTConfig::options().gestures.move_distance;
+    const int ROWS = HTConfig::options().grid.rows;
+    const int COLS = HTConfig::options().grid.cols;
     const CBox min_ws = calculate_ws_box(0, 0, HT_VIEW_CLOSED);
     const CBox max_ws = calculate_ws_box(COLS - 1, ROWS - 1, HT_VIEW_CLOSED);
 
@@ -370,27 +446,14 @@ void HTLayoutGrid::on_move(WORKSPACEID old_id, WORKSPACEID new_id, CallbackFun o
 }
 
 bool HTLayoutGrid::should_render_window(PHLWINDOW window) {
-    bool ori_result = HTLayoutBase::should_render_window(window);
-
-    const PHLMONITOR monitor = get_monitor();
-    if (window == nullptr || monitor == nullptr)
-        return ori_result;
-
-    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
-    if (target != nullptr && window == target->window())
-        return false;
-
-    PHLWORKSPACE workspace = window->m_workspace;
-    if (workspace == nullptr)
-        return false;
-
-    CBox window_box = get_global_window_box(window, window->workspaceID());
-    if (window_box.empty())
-        return false;
-    if (window_box.intersection(monitor->logicalBox()).empty())
+    // Worked out for every window at once by update_visible_windows
+    if (!is_window_visible(window))
         return false;
+    return HTLayoutBase::should_render_window(window);
+}
 
-    return ori_result;
+bool HTLayoutGrid::is_animating() {
+    return scale->isBeingAnimated() || offset->isBeingAnimated();
 }
 
 float HTLayoutGrid::drag_window_scale() {
@@ -422,89 +485,226 @@ void HTLayoutGrid::init_position() {
     scale->setValueAndWarp(1.f);
 }
 
-CBox HTLayoutGrid::calculate_ws_box(int x, int y, HTViewStage stage) {
+const HTGridGeometry& HTLayoutGrid::geometry() {
     const PHLMONITOR monitor = get_monitor();
-    if (monitor == nullptr)
-        return {};
-
-    // Monitor may not have its final size yet during connect/reconnect
-    if (monitor->m_transformedSize.x < 1 || monitor->m_transformedSize.y < 1)
-        return {};
-
-    const int ROWS = HTConfig::value<Config::INTEGER>("grid:rows");
-    const int COLS = HTConfig::value<Config::INTEGER>("grid:cols");
-    const int GAPS_USE_ASPECT_RATIO = HTConfig::value<Config::INTEGER>("grid:gaps_use_aspect_ratio");
-    const float GAP_SIZE = HTConfig::value<Config::FLOAT>("gap_size") * monitor->m_scale;
-    const Vector2D gaps = {
-        GAP_SIZE,
-        GAPS_USE_ASPECT_RATIO
-            ? GAP_SIZE * monitor->m_transformedSize.y / monitor->m_transformedSize.x
-            : GAP_SIZE
+    const HTGridMonitor snapshot = monitor == nullptr
+        ? HTGridMonitor {}
+        : HTGridMonitor {monitor->m_transformedSize, monitor->m_scale};
+    if (geometry_cache.has_value() && geometry_cache->monitor == snapshot
+        && geometry_cache->generation == layout_generation)
+        return geometry_cache->geometry;
+
+    const HTGridConfig config {
+        .rows = (int)HTConfig::options().grid.rows,
+        .cols = (int)HTConfig::options().grid.cols,
+        .gap_size = HTConfig::options().gap_size,
+        .gaps_use_aspect_ratio =
+            (bool)HTConfig::options().grid.gaps_use_aspect_ratio,
     };
+    geometry_cache = HTGeometryCache {snapshot, layout_generation, grid_geometry(snapshot, config)};
+    return geometry_cache->geometry;
+}
 
-    if (GAP_SIZE > std::min(monitor->m_transformedSize.x, monitor->m_transformedSize.y)
-        || GAP_SIZE < 0)
-        return {};
-
-    double render_x = (monitor->m_transformedSize.x - gaps.x * (COLS + 1)) / COLS;
-    double render_y = (monitor->m_transformedSize.y - gaps.y * (ROWS + 1)) / ROWS;
-    const double mon_aspect = monitor->m_transformedSize.x / monitor->m_transformedSize.y;
-    Vector2D start_offset {};
-
-    // make correct aspect ratio
-    if (render_y * mon_aspect > render_x) {
-        start_offset.y = (render_y - render_x / mon_aspect) * ROWS / 2.f;
-        render_y = render_x / mon_aspect;
-    } else if (render_x / mon_aspect > render_y) {
-        start_offset.x = (render_x - render_y * mon_aspect) * COLS / 2.f;
-        render_x = render_y * mon_aspect;
-    }
-
-    float use_scale = scale->value();
-    Vector2D use_offset = offset->value();
-    if (stage == HT_VIEW_CLOSED) {
-        use_scale = 1;
-        use_offset = Vector2D {0, 0};
-    } else if (stage == HT_VIEW_OPENED) {
-        use_scale = render_x / monitor->m_transformedSize.x;
-        use_offset = Vector2D {0, 0};
-    }
+std::pair<double, Vector2D> HTLayoutGrid::stage_pose(HTViewStage stage) {
+    if (stage == HT_VIEW_CLOSED)
+        return {1, Vector2D {0, 0}};
+    if (stage == HT_VIEW_OPENED)
+        return {geometry().open_scale, Vector2D {0, 0}};
+    return {scale->value(), offset->value()};
+}
 
-    const Vector2D ws_sz = monitor->m_transformedSize * use_scale;
-    return CBox {Vector2D {x, y} * (ws_sz + gaps) + gaps + use_offset + start_offset, ws_sz};
-};
+CBox HTLayoutGrid::calculate_ws_box(int x, int y, HTViewStage stage) {
+    const auto [use_scale, use_offset] = stage_pose(stage);
+    return geometry().tile_box(x, y, use_scale, use_offset);
+}
 
 void HTLayoutGrid::build_overview_layout(HTViewStage stage) {
     const PHLMONITOR monitor = get_monitor();
     if (monitor == nullptr)
         return;
 
-    const int ROWS = HTConfig::value<Config::INTEGER>("grid:rows");
-    const int COLS = HTConfig::value<Config::INTEGER>("grid:cols");
+    // Boxes only depend on these (and the config and slots, which bump the generation)
+    const HTLayoutInputs inputs {
+        .stage = stage,
+        .scale = scale->value(),
+        .offset = offset->value(),
+        .layer = layer,
+        .monitor_size = monitor->m_transformedSize,
+        .monitor_scale = monitor->m_scale,
+        .generation = layout_generation,
+    };
+    if (built_inputs == inputs)
+        return;
+    built_inputs = inputs;
 
-    const PHLMONITOR last_monitor = Desktop::focusState()->monitor();
-    Desktop::focusState()->rawMonitorFocus(monitor);
+    const HTGridGeometry& grid = geometry();
+    const auto [use_scale, use_offset] = stage_pose(stage);
+    grid.tile_boxes(use_scale, use_offset, tile_boxes);
 
-    overview_layout.clear();
-    for (int y = 0; y < ROWS; y++) {
-        for (int x = 0; x < COLS; x++) {
+    overview_layout.begin_update();
+    for (int y = 0; y < grid.rows; y++) {
+        for (int x = 0; x < grid.cols; x++) {
             const WORKSPACEID ws_id = slot_workspace(layer, x, y);
             if (ws_id == WORKSPACE_INVALID)
                 continue;
-            CBox ws_box = calculate_ws_box(x, y, stage);
+            CBox ws_box = tile_boxes[y * grid.cols + x];
             ws_box.round();
-            overview_layout[ws_id] = HTWorkspace {x, y, ws_box};
+            overview_layout.set(ws_id, HTWorkspace {x, y, ws_box});
         }
     }
+    if (overview_layout.end_update())
+        index_overview_layout();
+}
+
+bool HTLayoutGrid::tile_visible(PHLMONITOR monitor, const CBox& box) {
+    if (box.width < 0.01 || box.height < 0.01)
+        return false;
+    const float BORDERSIZE = HTConfig::options().border_size;
+    const CBox global_mon_box = {monitor->m_position, monitor->m_transformedSize};
+    CBox global_box = {box.pos() + monitor->m_position, box.size()};
+    return !global_box.expand(BORDERSIZE).intersection(global_mon_box).empty();
+}
 
-    if (last_monitor != nullptr)
-        Desktop::focusState()->rawMonitorFocus(last_monitor);
+void HTLayoutGrid::damage_workspace(WORKSPACEID workspace_id) {
+    thumbnails.damage(workspace_id);
 }
 
-// Render each visible workspace directly into its grid tile via a scaled
-// renderWorkspace (renderModif). The renderTexture hook keeps the per-surface
-// scissor in sync with that renderModif, so window contents aren't culled near
-// tile edges.
+void HTLayoutGrid::damage_all_workspaces() {
+    thumbnails.damage_all();
+}
+
+void HTLayoutGrid::damage_stale_tiles() {
+    const PHLMONITOR monitor = get_monitor();
+    if (monitor == nullptr)
+        return;
+    for (const auto& [ws_id, ws_layout] : overview_layout) {
+        if (!thumbnails.needs_refresh(ws_id) || !tile_visible(monitor, ws_layout.box))
+            continue;
+        g_pHyprRenderer->damageBox(get_global_ws_box(ws_id));
+    }
+}
+
+// Redraw the thumbnails of visible, non-active tiles whose workspace was damaged since their
+// last refresh. Runs before the monitor's render pass begins, as each refresh is its own render.
+// The active tile is rendered live and never waits; the others are held to
+// grid:inactive_refresh_interval and at most grid:inactive_tiles_per_frame refreshes per
+// frame, taken round-robin so a busy tile can't starve the rest.
+void HTLayoutGrid::pre_render() {
+    const PHTVIEW par_view = ht_manager->get_view_from_id(view_id);
+    if (par_view == nullptr)
+        return;
+    const PHLMONITOR monitor = par_view->get_monitor();
+    if (monitor == nullptr)
+        return;
+
+    if (!par_view->active) {
+        thumbnails.clear();
+        return;
+    }
+
+    const PHLWORKSPACE start_workspace = monitor->m_activeWorkspace;
+    if (start_workspace == nullptr)
+        return;
+
+    const auto REFRESH_INTERVAL = std::chrono::milliseconds(
+        std::max<Config::INTEGER>(0, HTConfig::options().grid.inactive_refresh_interval)
+    );
+    const size_t TILES_PER_FRAME =
+        std::max<Config::INTEGER>(0, HTConfig::options().grid.inactive_tiles_per_frame);
+    const auto now = Time::steadyNow();
+
+    build_overview_layout(HT_VIEW_ANIMATING);
+
+    // Tiles that were never rendered are always refreshed, otherwise they'd fall back to
+    // a live render, which costs more than the refresh itself.
+    std::vector<WORKSPACEID> stale;
+    std::vector<WORKSPACEID> due;
+    std::optional<Time::steady_tp> next_due;
+    for (const auto& [ws_id, ws_layout] : overview_layout) {
+        if (ws_id == start_workspace->m_id || !tile_visible(monitor, ws_layout.box))
+            continue;
+        if (!thumbnails.needs_refresh(ws_id))
+            continue;
+        if (!thumbnails.has(ws_id)) {
+            stale.push_back(ws_id);
+            continue;
+        }
+        const auto due_at = thumbnails.last_refresh(ws_id) + REFRESH_INTERVAL;
+        if (due_at <= now)
+            due.push_back(ws_id);
+        else if (!next_due.has_value() || due_at < *next_due)
+            next_due = due_at;
+    }
+
+    bool over_budget = false;
+    if (TILES_PER_FRAME > 0 && due.size() > TILES_PER_FRAME) {
+        // Resume after the last tile refreshed by the previous budgeted frame
+        std::sort(due.begin(), due.end());
+        const auto resume = std::upper_bound(due.begin(), due.end(), last_budget_refresh);
+        std::rotate(due.begin(), resume, due.end());
+        due.resize(TILES_PER_FRAME);
+        last_budget_refresh = due.back();
+        over_budget = true;
+    }
+    stale.insert(stale.end(), due.begin(), due.end());
+
+    if (next_due.has_value()) {
+        refresh_timer->updateTimeout(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(*next_due - now)
+        );
+    }
+
+    if (stale.empty())
+        return;
+
+    update_visible_windows();
+
+    // Same as render(): only when a stale tile needs the active-workspace swap, hide the real
+    // active workspace so its windows don't end up in the thumbnails, and restore it once
+    // every stale tile has been redrawn.
+    const bool needs_swap = std::ranges::any_of(stale, [&](WORKSPACEID ws_id) {
+        return !can_render_workspace_direct(
+            monitor, State::workspaceState()->query().id(ws_id).run()
+        );
+    });
+    if (needs_swap) {
+        Animation::Workspace::startAnimation(
+            start_workspace, Animation::Workspace::ANIMATION_TYPE_OUT, false, true
+        );
+        start_workspace->m_visible = false;
+    }
+
+    // With grid:thumbnail_lod, thumbnails are drawn at the size of an open tile instead of the
+    // monitor's. Tiles only grow past that while animating towards being closed.
+    const Vector2D thumbnail_size = HTConfig::options().grid.thumbnail_lod
+        ? calculate_ws_box(0, 0, HT_VIEW_OPENED).size()
+        : monitor->m_transformedSize;
+
+    for (const WORKSPACEID ws_id : stale) {
+        const PHLWORKSPACE workspace = State::workspaceState()->query().id(ws_id).run();
+        thumbnails.refresh(monitor, workspace, ws_id, thumbnail_size);
+        // The damage that made this tile stale may have been drawn frames ago
+        g_pHyprRenderer->damageBox(get_global_ws_box(ws_id));
+    }
+
+    if (needs_swap) {
+        monitor->m_activeWorkspace = start_workspace;
+        Animation::Workspace::startAnimation(
+            start_workspace, Animation::Workspace::ANIMATION_TYPE_IN, false, true
+        );
+        start_workspace->m_visible = true;
+    }
+
+    // Tiles left over by the budget are picked up by the next frame
+    if (over_budget)
+        damage_stale_tiles();
+}
+
+// Render each visible workspace into its grid tile. While the overview is open, non-active
+// tiles are drawn from their thumbnails (refreshed in pre_render) and only the active
+// workspace is rendered live, via a scaled renderWorkspace (renderModif). The renderTexture
+// hook keeps the per-surface scissor in sync with that renderModif, so window contents
+// aren't culled near tile edges.
 void HTLayoutGrid::render() {
     HTLayoutBase::render();
     CScopeGuard x([this] { post_render(); });
@@ -522,86 +722,101 @@ void HTLayoutGrid::render() {
     auto* const ACTIVECOL = (Config::CGradientValueData*)(PACTIVECOL.ptr());
     auto* const INACTIVECOL = (Config::CGradientValueData*)(PINACTIVECOL.ptr());
 
-    const float BORDERSIZE = HTConfig::value<Config::FLOAT>("border_size");
+    const float BORDERSIZE = HTConfig::options().border_size;
     const auto time = Time::steadyNow();
 
     CBox monitor_box = {{0, 0}, monitor->m_transformedSize};
 
-    CRectPassElement::SRectData bg;
-    bg.color = CHyprColor {HTConfig::value<Config::INTEGER>("bg_color")}.stripA();
-    bg.box = monitor_box;
-    g_pHyprRenderer->m_renderPass.add(makeUnique<CRectPassElement>(bg));
+    // Background and every tile border go out as one pass element
+    auto frame = makeUnique<HTBatchPassElement>();
+    frame->rects.push_back({
+        .box = monitor_box,
+        .color = CHyprColor {HTConfig::options().bg_color}.stripA(),
+    });
 
     build_overview_layout(HT_VIEW_ANIMATING);
+    update_visible_windows();
 
-    // Hyprland only fully renders the active workspace, so render_workspace_at_box
-    // swaps each tile's workspace in as it renders; capture the real active one to
-    // restore at the end and to pick out the active-border color.
+    // Tiles that can't be drawn directly have their workspace swapped in as the active one
+    // by render_workspace_at_box; capture the real active one to restore at the end and to
+    // pick out the active-border color.
     const PHLWORKSPACE start_workspace = monitor->m_activeWorkspace;
-    if (start_workspace == nullptr)
+    if (start_workspace == nullptr) {
+        g_pHyprRenderer->m_renderPass.add(std::move(frame));
         return;
-    Animation::Workspace::startAnimation(
-        start_workspace, Animation::Workspace::ANIMATION_TYPE_OUT, false, true
-    );
-    start_workspace->m_visible = false;
-
-    CBox global_mon_box = {monitor->m_position, monitor->m_transformedSize};
-    const auto tile_visible = [&](const CBox& box) {
-        if (box.width < 0.01 || box.height < 0.01)
-            return false;
-        CBox global_box = {box.pos() + monitor->m_position, box.size()};
-        return !global_box.expand(BORDERSIZE).intersection(global_mon_box).empty();
-    };
+    }
 
     // Borders first, so window contents render on top of them. Workspace contents now
     // render unclipped (a window moving to a new workspace on release can extend past
     // its tile), and should not be covered by the tile borders.
+    frame->borders.reserve(overview_layout.size());
     for (const auto& [ws_id, ws_layout] : overview_layout) {
-        if (!tile_visible(ws_layout.box))
+        if (!tile_visible(monitor, ws_layout.box))
             continue;
-        CBorderPassElement::SBorderData bdata;
-        bdata.box = ws_layout.box;
-        bdata.grad1 = start_workspace->m_id == ws_id ? *ACTIVECOL : *INACTIVECOL;
-        bdata.borderSize = BORDERSIZE;
-        g_pHyprRenderer->m_renderPass.add(makeUnique<CBorderPassElement>(bdata));
+        frame->borders.push_back({
+            .box = ws_layout.box,
+            .grad = start_workspace->m_id == ws_id ? *ACTIVECOL : *INACTIVECOL,
+            .border_size = BORDERSIZE,
+        });
     }
 
-    // workspace may be nullptr for empty/never-visited slots: render_workspace_at_box
-    // still draws their background + wallpaper layers so the tile isn't blank. Render
-    // the active workspace last so its windows (e.g. one just dropped) stay on top of
-    // the neighbouring tiles.
+    // Thumbnails join the same pass element, drawn after the borders
+    std::vector<std::pair<PHLWORKSPACE, CBox>> live_tiles;
+    bool needs_swap = false;
     for (const auto& [ws_id, ws_layout] : overview_layout) {
-        if (!tile_visible(ws_layout.box) || ws_id == start_workspace->m_id)
+        if (!tile_visible(monitor, ws_layout.box) || ws_id == start_workspace->m_id)
             continue;
-        render_workspace_at_box(monitor, State::workspaceState()->query().id(ws_id).run(), time, ws_layout.box);
+
+        const SP<Render::ITexture> thumbnail =
+            par_view->active ? thumbnails.texture(ws_id) : nullptr;
+        if (thumbnail == nullptr) {
+            const PHLWORKSPACE workspace = State::workspaceState()->query().id(ws_id).run();
+            needs_swap = needs_swap || !can_render_workspace_direct(monitor, workspace);
+            live_tiles.emplace_back(workspace, ws_layout.box);
+            continue;
+        }
+
+        frame->textures.push_back({
+            .tex = thumbnail,
+            .box = thumbnails.texture_box(ws_id, ws_layout.box),
+            .clip = ws_layout.box,
+        });
+    }
+    g_pHyprRenderer->m_renderPass.add(std::move(frame));
+
+    // workspace may be nullptr for empty/never-visited slots: render_workspace_at_box
+    // still draws their background + wallpaper layers so the tile isn't blank. The active
+    // workspace is only hidden (and its animations restarted) when some live tile can't be
+    // drawn directly and needs the active-workspace swap.
+    if (needs_swap) {
+        Animation::Workspace::startAnimation(
+            start_workspace, Animation::Workspace::ANIMATION_TYPE_OUT, false, true
+        );
+        start_workspace->m_visible = false;
     }
+
+    for (const auto& [workspace, box] : live_tiles)
+        render_workspace_at_box(monitor, workspace, time, box);
+
+    if (needs_swap) {
+        monitor->m_activeWorkspace = start_workspace;
+        Animation::Workspace::startAnimation(
+            start_workspace, Animation::Workspace::ANIMATION_TYPE_IN, false, true
+        );
+        start_workspace->m_visible = true;
+    }
+
+    // Render the active workspace last so its windows (e.g. one just dropped) stay on top
+    // of the neighbouring tiles.
     if (const auto it = overview_layout.find(start_workspace->m_id);
-        it != overview_layout.end() && tile_visible(it->second.box))
+        it != overview_layout.end() && tile_visible(monitor, it->second.box))
         render_workspace_at_box(monitor, start_workspace, time, it->second.box);
 
-    monitor->m_activeWorkspace = start_workspace;
-    Animation::Workspace::startAnimation(
-        start_workspace, Animation::Workspace::ANIMATION_TYPE_IN, false, true
-    );
-    start_workspace->m_visible = true;
-
-    g_pHyprRenderer->damageMonitor(monitor);
+    // Settled overviews are redrawn only for the damage reported by their contents (see
+    // HTLayoutBase::damage_window); moving tiles have to be redrawn in full.
+    if (is_animating())
+        g_pHyprRenderer->damageMonitor(monitor);
 
     // Dragged window rendered on top, following the cursor.
-    const PHTVIEW cursor_view = ht_manager->get_view_from_cursor();
-    if (cursor_view == nullptr)
-        return;
-    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
-    if (target == nullptr)
-        return;
-    const PHLWINDOW dragged_window = target->window();
-    if (dragged_window == nullptr)
-        return;
-    const Vector2D mouse_coords = g_pInputManager->getMouseCoordsInternal();
-    const CBox window_box = dragged_window->getWindowMainSurfaceBox()
-                                .translate(-mouse_coords)
-                                .scale(cursor_view->layout->drag_window_scale())
-                                .translate(mouse_coords);
-    if (!window_box.intersection(monitor->logicalBox()).empty())
-        render_window_at_box(dragged_window, monitor, time, window_box);
+    ht_manager->render_drag_window(monitor, time);
 }
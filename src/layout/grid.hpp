@@ -1,10 +1,15 @@
 #pragma once
 
 #include <hyprland/src/helpers/AnimatedVariable.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopTimer.hpp>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include "../thumbnail.hpp"
 #include "../types.hpp"
+#include "grid_geometry.hpp"
 #include "layout_base.hpp"
 
 struct HTGridSlot {
@@ -20,13 +25,69 @@ class HTLayoutGrid: public HTLayoutBase {
 
     // Survives workspace destruction so a slot stays sticky for an empty ws.
     std::unordered_map<WORKSPACEID, HTGridSlot> ws_slot_cache;
-    std::unordered_map<long long, WORKSPACEID> slot_ws_cache;
+    // Workspace of every slot, layer-major: index (layer * rows + y) * cols + x
+    std::vector<WORKSPACEID> slot_ws_table;
+    int table_layers = 0;
+    int table_rows = 0;
+    int table_cols = 0;
 
-    static long long pack_slot(int layer, int x, int y);
+    // Inputs of the last build_overview_layout; an unchanged layout is not rebuilt
+    struct HTLayoutInputs {
+        HTViewStage stage;
+        float scale;
+        Vector2D offset;
+        int layer;
+        Vector2D monitor_size;
+        double monitor_scale;
+        uint64_t generation;
+
+        bool operator==(const HTLayoutInputs&) const = default;
+    };
+    std::optional<HTLayoutInputs> built_inputs;
+
+    // Geometry for the monitor and config it was computed from
+    struct HTGeometryCache {
+        HTGridMonitor monitor;
+        uint64_t generation;
+        HTGridGeometry geometry;
+    };
+    std::optional<HTGeometryCache> geometry_cache;
+    // Scratch for build_overview_layout, kept to reuse the buffer
+    std::vector<CBox> tile_boxes;
+
+    const HTGridGeometry& geometry();
+    // Scale and offset of the whole grid at `stage`
+    std::pair<double, Vector2D> stage_pose(HTViewStage stage);
+
+    // Offscreen copies of the non-active tiles, only kept while the overview is open.
+    HTThumbnailCache thumbnails;
+    // Wakes up the overview once a rate-limited tile is due for a refresh
+    SP<CEventLoopTimer> refresh_timer;
+    // Round-robin position of the per-frame refresh budget
+    WORKSPACEID last_budget_refresh = WORKSPACE_INVALID;
+
+    // One bit per slot of slot_ws_table, set while it holds a live or rule-bound workspace.
+    // The other slots hold placeholder ids and are free for new workspaces.
+    std::vector<uint64_t> reserved_slots;
+    // Rule-bound workspaces on this grid, whose slots stay reserved while they don't exist
+    std::unordered_set<WORKSPACEID> bound_workspaces;
+
+    // Index into slot_ws_table, or -1 outside the grid the table was built for
+    long long slot_index(int layer, int x, int y) const;
+    HTGridSlot slot_at(size_t idx) const;
+    bool slot_reserved(size_t idx) const;
+    void set_slot_reserved(size_t idx, bool reserved);
+    // First free slot at or after `from`, or -1
+    long long next_free_slot(size_t from) const;
+    void place_workspace(WORKSPACEID id, size_t idx, bool reserve);
+
+    bool tile_visible(PHLMONITOR monitor, const CBox& box);
+    // Damage the on-screen rect of every visible tile with a stale thumbnail
+    void damage_stale_tiles();
 
   public:
     HTLayoutGrid(VIEWID view_id);
-    virtual ~HTLayoutGrid() = default;
+    virtual ~HTLayoutGrid();
 
     virtual std::string layout_name();
 
@@ -42,12 +103,23 @@ class HTLayoutGrid: public HTLayoutBase {
     virtual WORKSPACEID get_ws_id_in_direction(int x, int y, std::string& direction);
 
     virtual bool should_render_window(PHLWINDOW window);
+    virtual bool is_animating();
     virtual float drag_window_scale();
     virtual void init_position();
     virtual void build_overview_layout(HTViewStage stage);
+    virtual void pre_render();
     virtual void render();
 
+    virtual void damage_workspace(WORKSPACEID workspace_id);
+    virtual void damage_all_workspaces();
+
     void refresh_workspace_cache(const std::unordered_set<WORKSPACEID>& extra_off_limits = {});
+    // Update the slots for a single workspace, without a full refresh. The workspace appeared on
+    // this monitor (created, or moved here). The caller makes sure no other grid maps its id.
+    void add_workspace(WORKSPACEID id);
+    // The workspace was destroyed, or `moved` to another monitor. Returns false if the caches
+    // must be rebuilt with HTManager::refresh_all_grid_caches instead.
+    bool remove_workspace(WORKSPACEID id, bool moved);
     WORKSPACEID slot_workspace(int layer, int x, int y);
 
     const std::unordered_map<WORKSPACEID, HTGridSlot>& cache() const { return ws_slot_cache; }
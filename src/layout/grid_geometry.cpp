@@ -0,0 +1,64 @@
+#include "grid_geometry.hpp"
+
+#include <algorithm>
+
+HTGridGeometry grid_geometry(const HTGridMonitor& monitor, const HTGridConfig& config) {
+    // Invalid geometries keep their rows and cols, so the grid still has (empty) tiles
+    const HTGridGeometry invalid {.rows = std::max(config.rows, 0), .cols = std::max(config.cols, 0)};
+
+    const Vector2D size = monitor.size;
+    // Monitor may not have its final size yet during connect/reconnect
+    if (size.x < 1 || size.y < 1 || config.rows <= 0 || config.cols <= 0)
+        return invalid;
+
+    const double gap_size = config.gap_size * monitor.scale;
+    if (gap_size > std::min(size.x, size.y) || gap_size < 0)
+        return invalid;
+    const Vector2D gaps = {
+        gap_size,
+        config.gaps_use_aspect_ratio ? gap_size * size.y / size.x : gap_size
+    };
+
+    double render_x = (size.x - gaps.x * (config.cols + 1)) / config.cols;
+    double render_y = (size.y - gaps.y * (config.rows + 1)) / config.rows;
+    const double mon_aspect = size.x / size.y;
+    Vector2D start_offset {};
+
+    // make correct aspect ratio
+    if (render_y * mon_aspect > render_x) {
+        start_offset.y = (render_y - render_x / mon_aspect) * config.rows / 2.f;
+        render_y = render_x / mon_aspect;
+    } else if (render_x / mon_aspect > render_y) {
+        start_offset.x = (render_x - render_y * mon_aspect) * config.cols / 2.f;
+        render_x = render_y * mon_aspect;
+    }
+
+    return HTGridGeometry {
+        .rows = config.rows,
+        .cols = config.cols,
+        .monitor_size = size,
+        .gaps = gaps,
+        .start_offset = start_offset,
+        .open_scale = render_x / size.x,
+    };
+}
+
+CBox HTGridGeometry::tile_box(int x, int y, double scale, Vector2D offset) const {
+    if (!valid())
+        return {};
+    const Vector2D ws_sz = monitor_size * scale;
+    return CBox {Vector2D {x, y} * (ws_sz + gaps) + gaps + offset + start_offset, ws_sz};
+}
+
+void HTGridGeometry::tile_boxes(double scale, Vector2D offset, std::vector<CBox>& out) const {
+    out.clear();
+    if (!valid()) {
+        out.resize((size_t)rows * cols);
+        return;
+    }
+    const Vector2D ws_sz = monitor_size * scale;
+    const Vector2D origin = gaps + offset + start_offset;
+    for (int y = 0; y < rows; y++)
+        for (int x = 0; x < cols; x++)
+            out.emplace_back(Vector2D {x, y} * (ws_sz + gaps) + origin, ws_sz);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <hyprutils/math/Box.hpp>
+#include <hyprutils/math/Vector2D.hpp>
+#include <vector>
+
+// Tile geometry of the grid layout. Pure arithmetic on a snapshot of the monitor and the
+// config, so it never touches compositor state and can be exercised on its own.
+
+using Hyprutils::Math::CBox;
+using Hyprutils::Math::Vector2D;
+
+// The monitor state the geometry depends on
+struct HTGridMonitor {
+    // Transformed size, in pixels
+    Vector2D size;
+    double scale = 1;
+
+    bool operator==(const HTGridMonitor&) const = default;
+};
+
+struct HTGridConfig {
+    int rows = 0;
+    int cols = 0;
+    // In logical pixels
+    float gap_size = 0;
+    bool gaps_use_aspect_ratio = false;
+
+    bool operator==(const HTGridConfig&) const = default;
+};
+
+// Measures shared by every tile of a grid on one monitor
+struct HTGridGeometry {
+    int rows = 0;
+    int cols = 0;
+    Vector2D monitor_size;
+    Vector2D gaps;
+    // Centers the grid when the tiles can't fill the monitor at its aspect ratio
+    Vector2D start_offset;
+    // Scale of a tile while the overview is fully open
+    double open_scale = 0;
+
+    // False if the monitor has no size yet or the config can't fit
+    bool valid() const { return rows > 0 && cols > 0 && open_scale > 0; }
+
+    // Box of the tile at (x, y), with the grid scaled by `scale` and moved by `offset`. Empty
+    // if invalid.
+    CBox tile_box(int x, int y, double scale, Vector2D offset) const;
+    // Boxes of all tiles, row-major, into `out` (reusing its buffer). Empty boxes if invalid.
+    void tile_boxes(double scale, Vector2D offset, std::vector<CBox>& out) const;
+};
+
+HTGridGeometry grid_geometry(const HTGridMonitor& monitor, const HTGridConfig& config);
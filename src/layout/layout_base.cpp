@@ -1,23 +1,26 @@
 #include <algorithm>
 #include <any>
+#include <array>
 #include <cmath>
+#include <list>
 #include <sstream>
 #include <string_view>
 
 #define private public
 #include <hyprland/src/config/ConfigManager.hpp>
 #include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/desktop/view/Popup.hpp>
+#include <hyprland/src/layout/LayoutManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
 #include <hyprland/src/render/Renderer.hpp>
 #include <hyprland/src/render/pass/ClearPassElement.hpp>
 #include <hyprland/src/state/WorkspaceState.hpp>
-#include <hyprland/src/render/pass/RectPassElement.hpp>
-#include <hyprland/src/render/pass/TexPassElement.hpp>
 #undef private
 
 #include "../config.hpp"
 #include "../globals.hpp"
 #include "../pass/pass_element.hpp"
+#include "../render.hpp"
 #include "../types.hpp"
 #include "layout_base.hpp"
 
@@ -60,6 +63,12 @@ bool HTLayoutBase::should_render_window(PHLWINDOW window) {
     const PHLMONITOR monitor = get_monitor();
     if (monitor == nullptr || window == nullptr)
         return false;
+    // Drawn at the cursor instead, whether or not its workspace is a tile in the layout
+    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
+    if (target != nullptr && window == target->window())
+        return false;
+    if (is_occluded(window))
+        return false;
 
     return ((should_render_window_t)(should_render_window_hook->m_original))(
         g_pHyprRenderer.get(),
@@ -68,6 +77,10 @@ bool HTLayoutBase::should_render_window(PHLWINDOW window) {
     );
 }
 
+bool HTLayoutBase::is_animating() {
+    return false;
+}
+
 float HTLayoutBase::drag_window_scale() {
     return 1.f;
 }
@@ -80,42 +93,249 @@ void HTLayoutBase::build_overview_layout(HTViewStage stage) {
     ;
 }
 
+void HTLayoutBase::invalidate_overview_layout() {
+    layout_generation++;
+}
+
+HTLayoutBase::HTLayoutStore::iterator HTLayoutBase::HTLayoutStore::find(WORKSPACEID id) {
+    const auto it = positions.find(id);
+    return it == positions.end() ? entries.end() : entries.begin() + it->second;
+}
+
+HTLayoutBase::HTLayoutStore::const_iterator
+HTLayoutBase::HTLayoutStore::find(WORKSPACEID id) const {
+    const auto it = positions.find(id);
+    return it == positions.end() ? entries.end() : entries.begin() + it->second;
+}
+
+const HTLayoutBase::HTWorkspace& HTLayoutBase::HTLayoutStore::operator[](WORKSPACEID id) const {
+    static const HTWorkspace EMPTY {};
+    const auto it = find(id);
+    return it == entries.end() ? EMPTY : it->second;
+}
+
+void HTLayoutBase::HTLayoutStore::begin_update() {
+    cursor = 0;
+    ids_changed = false;
+    positions_changed = false;
+    changed = false;
+}
+
+void HTLayoutBase::HTLayoutStore::set(WORKSPACEID id, const HTWorkspace& workspace) {
+    if (cursor == entries.size()) {
+        entries.emplace_back(id, workspace);
+        ids_changed = true;
+        changed = true;
+    } else {
+        Entry& entry = entries[cursor];
+        if (entry.first != id) {
+            entry.first = id;
+            ids_changed = true;
+        }
+        if (entry.second.x != workspace.x || entry.second.y != workspace.y)
+            positions_changed = true;
+        if (ids_changed || positions_changed || entry.second.box != workspace.box) {
+            entry.second = workspace;
+            changed = true;
+        }
+    }
+    cursor++;
+}
+
+bool HTLayoutBase::HTLayoutStore::end_update() {
+    if (cursor != entries.size()) {
+        entries.erase(entries.begin() + cursor, entries.end());
+        ids_changed = true;
+        changed = true;
+    }
+    // Only a change in the workspace set touches the map
+    if (ids_changed) {
+        positions.clear();
+        for (size_t i = 0; i < entries.size(); i++)
+            positions[entries[i].first] = i;
+    }
+    return changed;
+}
+
+void HTLayoutBase::pre_render() {
+    ;
+}
+
+void HTLayoutBase::damage_workspace(WORKSPACEID workspace_id) {
+    ;
+}
+
+void HTLayoutBase::damage_all_workspaces() {
+    ;
+}
+
+void HTLayoutBase::damage_window(PHLWINDOW window) {
+    if (window == nullptr)
+        return;
+
+    const WORKSPACEID workspace_id = window->workspaceID();
+    damage_workspace(workspace_id);
+
+    const PHTVIEW view = ht_manager->get_view_from_id(view_id);
+    const PHLMONITOR monitor = get_monitor();
+    if (view == nullptr || monitor == nullptr || !(view->active || view->navigating))
+        return;
+
+    const auto layout_it = overview_layout.find(workspace_id);
+    if (layout_it == overview_layout.end() || layout_it->second.box.empty())
+        return;
+
+    // Hyprland damages the window at its unscaled desktop position; in the overview it is
+    // drawn scaled inside its tile, so damage that rect too (decorations included).
+    const CBox ws_window_box = window->getFullWindowBoundingBox();
+    const Vector2D top_left =
+        local_ws_unscaled_to_global(ws_window_box.pos() - monitor->m_position, workspace_id);
+    const Vector2D bottom_right = local_ws_unscaled_to_global(
+        ws_window_box.pos() + ws_window_box.size() - monitor->m_position,
+        workspace_id
+    );
+    CBox damage_box = {top_left, bottom_right - top_left};
+    g_pHyprRenderer->damageBox(damage_box.expand(1));
+}
+
 void HTLayoutBase::render() {
     CClearPassElement::SClearData data;
     data.color = CHyprColor {0};
     g_pHyprRenderer->m_renderPass.add(makeUnique<CClearPassElement>(data));
 }
 
-std::vector<WORKSPACEID> HTLayoutBase::jump_targets() const {
-    std::vector<std::pair<WORKSPACEID, HTWorkspace>> ordered;
-    ordered.reserve(overview_layout.size());
-    for (const auto& entry : overview_layout)
-        ordered.push_back(entry);
+void HTLayoutBase::update_visible_windows() {
+    occluded_windows.clear();
+    visible_windows.clear();
+    window_hits.clear();
 
-    std::sort(ordered.begin(), ordered.end(), [](const auto& lhs, const auto& rhs) {
-        if (lhs.second.y != rhs.second.y)
-            return lhs.second.y < rhs.second.y;
-        if (lhs.second.x != rhs.second.x)
-            return lhs.second.x < rhs.second.x;
-        return lhs.first < rhs.first;
-    });
+    const PHLMONITOR monitor = get_monitor();
+    if (monitor == nullptr)
+        return;
+    const CBox monitor_box = monitor->logicalBox();
+
+    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
+    const PHLWINDOW dragged_window = target == nullptr ? nullptr : target->window();
 
-    std::vector<WORKSPACEID> result;
-    result.reserve(ordered.size());
-    for (const auto& entry : ordered)
-        result.push_back(entry.first);
-    return result;
+    for (const auto& [ws_id, ws_layout] : overview_layout) {
+        const PHLWORKSPACE workspace = State::workspaceState()->query().id(ws_id).run();
+        if (workspace == nullptr)
+            continue;
+
+        // Walk from the top of the stack down, accumulating what opaque windows cover
+        const std::vector<PHLWINDOW> windows = workspace_windows_in_order(workspace);
+        CRegion coverage;
+        for (auto it = windows.rbegin(); it != windows.rend(); it++) {
+            const PHLWINDOW& window = *it;
+            // Drawn at the cursor instead of on its tile
+            if (window == dragged_window) {
+                occluded_windows.insert(window.get());
+                continue;
+            }
+
+            CBox window_box = get_global_window_box(window, ws_id);
+            if (window_box.empty())
+                continue;
+
+            // Maps a box around the window onto the tile, like the main surface
+            const CBox main_box = window->getWindowMainSurfaceBox();
+            const double tile_scale = window_box.w / std::max(main_box.w, 1.0);
+            const auto to_tile = [&](const CBox& box) {
+                return CBox {
+                    window_box.pos() + (box.pos() - main_box.pos()) * tile_scale,
+                    box.size() * tile_scale
+                };
+            };
+            // Border and shadow
+            const CBox full_tile_box = to_tile(window->getFullWindowBoundingBox());
+
+            // Popups reach past any box, so a window with some open is never culled (the
+            // popup head itself counts as one)
+            const bool has_popups =
+                window->m_popupHead != nullptr && window->m_popupHead->size() > 1;
+            if (!has_popups && !coverage.empty()
+                && CRegion {full_tile_box}.subtract(coverage).empty()) {
+                occluded_windows.insert(window.get());
+                continue;
+            }
+            if (!full_tile_box.intersection(monitor_box).empty()) {
+                visible_windows.insert(window.get());
+                // Closing windows still fade out on the tile but can't be picked. Borders and
+                // resize extents are hit like Hyprland's windowAt does.
+                if (window->m_isMapped) {
+                    const CBox hit_box = to_tile(window->getWindowBoxUnified(
+                        Desktop::View::RESERVED_EXTENTS | Desktop::View::INPUT_EXTENTS
+                    ));
+                    window_hits.push_back({window, hit_box});
+                }
+            }
+
+            if (!window->opaque())
+                continue;
+            // Rounded corners let whatever is below show through
+            window_box.expand(-window->rounding() * tile_scale);
+            if (window_box.w > 0 && window_box.h > 0)
+                coverage.add(window_box);
+        }
+    }
+}
+
+PHLWINDOW HTLayoutBase::window_at(Vector2D pos) const {
+    for (const HTWindowHit& hit : window_hits) {
+        if (!hit.box.containsPoint(pos))
+            continue;
+        if (const PHLWINDOW window = hit.window.lock(); window != nullptr)
+            return window;
+    }
+    return nullptr;
+}
+
+bool HTLayoutBase::is_occluded(PHLWINDOW window) const {
+    return window != nullptr && occluded_windows.contains(window.get());
+}
+
+bool HTLayoutBase::is_window_visible(PHLWINDOW window) const {
+    return window != nullptr && visible_windows.contains(window.get());
 }
 
 std::optional<WORKSPACEID> HTLayoutBase::jump_target(size_t index) const {
-    const auto targets = jump_targets();
-    if (index >= targets.size())
+    if (index >= jump_order.size())
         return std::nullopt;
-    return targets[index];
+    return jump_order[index];
+}
+
+static constexpr std::string_view LABELS = "1234567890abcdefghijklmnopqrstuvwxyz";
+
+// Jump label glyphs rasterized in one style, indexed like LABELS
+struct HTGlyphSet {
+    int font_size;
+    Config::INTEGER color;
+    std::array<SP<Render::ITexture>, LABELS.size()> glyphs;
+};
+
+// Styles only change with a monitor's scale or the config, so a few cover every monitor.
+static constexpr size_t MAX_GLYPH_SETS = 4;
+
+// Most recently used first; the least recently used style is dropped past MAX_GLYPH_SETS.
+static HTGlyphSet& glyph_set(int font_size, Config::INTEGER color) {
+    static std::list<HTGlyphSet> glyph_sets;
+
+    const auto it = std::find_if(glyph_sets.begin(), glyph_sets.end(), [&](const auto& set) {
+        return set.font_size == font_size && set.color == color;
+    });
+    if (it != glyph_sets.end()) {
+        glyph_sets.splice(glyph_sets.begin(), glyph_sets, it);
+        return glyph_sets.front();
+    }
+
+    glyph_sets.push_front({.font_size = font_size, .color = color, .glyphs = {}});
+    if (glyph_sets.size() > MAX_GLYPH_SETS)
+        glyph_sets.pop_back();
+    return glyph_sets.front();
 }
 
 void HTLayoutBase::render_jump_labels() {
-    if (!HTConfig::value<Config::INTEGER>("jump:enabled"))
+    if (!HTConfig::options().jump.enabled)
         return;
 
     const PHTVIEW view = ht_manager->get_view_from_id(view_id);
@@ -123,20 +343,22 @@ void HTLayoutBase::render_jump_labels() {
     if (view == nullptr || monitor == nullptr || !view->active || view->closing)
         return;
 
-    static constexpr std::string_view LABELS = "1234567890abcdefghijklmnopqrstuvwxyz";
-    const auto targets = jump_targets();
+    const std::vector<WORKSPACEID>& targets = jump_targets();
     const size_t count = std::min(targets.size(), LABELS.size());
 
     const int font_size = std::max(
         1,
-        static_cast<int>(HTConfig::value<Config::INTEGER>("jump:label_size") * monitor->m_scale)
+        static_cast<int>(HTConfig::options().jump.label_size * monitor->m_scale)
     );
     const float padding = std::max(4.f, font_size * 0.35f);
-    const Config::INTEGER label_color_value = HTConfig::value<Config::INTEGER>("jump:label_color");
+    const Config::INTEGER label_color_value = HTConfig::options().jump.label_color;
     const CHyprColor label_color {label_color_value};
-    const CHyprColor background_color {HTConfig::value<Config::INTEGER>("jump:label_background")};
+    const CHyprColor background_color {HTConfig::options().jump.label_background};
     const CBox monitor_box {{0, 0}, monitor->m_transformedSize};
+    HTGlyphSet& glyphs = glyph_set(font_size, label_color_value);
 
+    // Every badge and glyph go out as one pass element
+    auto labels = makeUnique<HTBatchPassElement>();
     for (size_t i = 0; i < count; i++) {
         const auto layout_it = overview_layout.find(targets[i]);
         if (layout_it == overview_layout.end())
@@ -146,11 +368,8 @@ void HTLayoutBase::render_jump_labels() {
             continue;
 
         // Text rasterization is relatively expensive and these glyphs are immutable for a
-        // given scale/color, so retain one texture per rendered label style.
-        static std::unordered_map<std::string, SP<Render::ITexture>> texture_cache;
-        const std::string texture_key = std::string(1, LABELS[i]) + ":" + std::to_string(font_size)
-            + ":" + std::to_string(label_color_value);
-        auto& texture = texture_cache[texture_key];
+        // given scale/color, so each is rasterized once per style.
+        auto& texture = glyphs.glyphs[i];
         if (texture == nullptr) {
             texture = g_pHyprRenderer->renderText(
                 std::string(1, LABELS[i]),
@@ -169,28 +388,21 @@ void HTLayoutBase::render_jump_labels() {
         const Vector2D badge_pos = workspace_box.pos() + (workspace_box.size() - badge_size) / 2.f;
         const CBox badge_box {badge_pos, badge_size};
 
-        CRectPassElement::SRectData badge;
-        badge.box = badge_box;
-        badge.color = background_color;
-        badge.round = std::round(std::min(badge_size.x, badge_size.y) * 0.22f);
-        g_pHyprRenderer->m_renderPass.add(makeUnique<CRectPassElement>(badge));
-
-        CTexPassElement::SRenderData text;
-        text.tex = texture;
-        text.box = CBox {badge_pos + (badge_size - texture->m_size) / 2.f, texture->m_size};
-        g_pHyprRenderer->m_renderPass.add(makeUnique<CTexPassElement>(std::move(text)));
+        labels->rects.push_back({
+            .box = badge_box,
+            .color = background_color,
+            .round = (int)std::round(std::min(badge_size.x, badge_size.y) * 0.22f),
+        });
+        labels->textures.push_back({
+            .tex = texture,
+            .box = CBox {badge_pos + (badge_size - texture->m_size) / 2.f, texture->m_size},
+        });
     }
+    if (!labels->empty())
+        g_pHyprRenderer->m_renderPass.add(std::move(labels));
 }
 
-const std::string CLEAR_PASS_ELEMENT_NAME = "CClearPassElement";
-
 void HTLayoutBase::post_render() {
-    bool first = true;
-    std::erase_if(g_pHyprRenderer->m_renderPass.m_passElements, [&first](const auto& e) {
-        bool res = e.element->passName() == CLEAR_PASS_ELEMENT_NAME && !first;
-        first = false;
-        return res;
-    });
     render_jump_labels();
     g_pHyprRenderer->m_renderPass.add(makeUnique<HTPassElement>());
     // g_pHyprOpenGL->setDamage(CRegion {CBox {0, 0, INT32_MAX, INT32_MAX}});
@@ -211,20 +423,138 @@ WORKSPACEID HTLayoutBase::get_ws_id_from_global(Vector2D pos) {
     if (!monitor->logicalBox().containsPoint(pos))
         return WORKSPACE_INVALID;
 
-    Vector2D relative_pos = (pos - monitor->m_position) * monitor->m_scale;
-    for (const auto& [id, layout] : overview_layout)
-        if (layout.box.containsPoint(relative_pos))
-            return id;
+    const Vector2D relative_pos = (pos - monitor->m_position) * monitor->m_scale;
+    if (tile_index.cols == 0)
+        return WORKSPACE_INVALID;
 
+    const Vector2D cell_pos = (relative_pos - tile_index.origin) / tile_index.cell;
+    const int cell_x = std::floor(cell_pos.x);
+    const int cell_y = std::floor(cell_pos.y);
+    if (cell_x < 0 || cell_y < 0 || cell_x >= tile_index.cols || cell_y >= tile_index.rows)
+        return WORKSPACE_INVALID;
+
+    const size_t bucket = (size_t)cell_y * tile_index.cols + cell_x;
+    for (size_t i = tile_index.bucket_start[bucket]; i < tile_index.bucket_start[bucket + 1]; i++) {
+        const WORKSPACEID id = tile_index.bucket_tiles[i];
+        const auto it = overview_layout.find(id);
+        if (it != overview_layout.end() && it->second.box.containsPoint(relative_pos))
+            return id;
+    }
     return WORKSPACE_INVALID;
 }
 
-WORKSPACEID HTLayoutBase::get_ws_id_from_xy(int x, int y) {
+// Both layouts give every tile the same size, so with buckets of that size each tile lands in
+// at most four of them. Capped so tiles shrunk to nearly nothing can't blow up the table.
+static constexpr int MAX_INDEX_CELLS = 64;
+
+void HTLayoutBase::update_jump_order() {
+    jump_order.clear();
     for (const auto& [id, layout] : overview_layout)
-        if (layout.x == x && layout.y == y)
-            return id;
+        jump_order.push_back(id);
+    std::sort(jump_order.begin(), jump_order.end(), [this](WORKSPACEID lhs, WORKSPACEID rhs) {
+        const HTWorkspace& lhs_layout = overview_layout[lhs];
+        const HTWorkspace& rhs_layout = overview_layout[rhs];
+        if (lhs_layout.y != rhs_layout.y)
+            return lhs_layout.y < rhs_layout.y;
+        if (lhs_layout.x != rhs_layout.x)
+            return lhs_layout.x < rhs_layout.x;
+        return lhs < rhs;
+    });
+}
 
-    return WORKSPACE_INVALID;
+void HTLayoutBase::index_overview_layout() {
+    // Reset in place, so rebuilding over the same tiles reuses every buffer
+    tile_index.origin = {};
+    tile_index.cell = {};
+    tile_index.cols = 0;
+    tile_index.rows = 0;
+    tile_index.bucket_start.clear();
+    tile_index.bucket_tiles.clear();
+    tile_index.slot_cols = 0;
+
+    if (overview_layout.slots_changed())
+        update_jump_order();
+
+    int slot_rows = 0;
+    for (const auto& [id, layout] : overview_layout) {
+        tile_index.slot_cols = std::max(tile_index.slot_cols, layout.x + 1);
+        slot_rows = std::max(slot_rows, layout.y + 1);
+    }
+    tile_index.slots.assign((size_t)tile_index.slot_cols * slot_rows, WORKSPACE_INVALID);
+    for (const auto& [id, layout] : overview_layout) {
+        if (layout.x >= 0 && layout.y >= 0)
+            tile_index.slots[(size_t)layout.y * tile_index.slot_cols + layout.x] = id;
+    }
+
+    Vector2D min = {INFINITY, INFINITY};
+    Vector2D max = {-INFINITY, -INFINITY};
+    Vector2D cell = {INFINITY, INFINITY};
+    for (const auto& [id, layout] : overview_layout) {
+        const CBox& box = layout.box;
+        if (box.w <= 0 || box.h <= 0)
+            continue;
+        min = {std::min(min.x, box.x), std::min(min.y, box.y)};
+        max = {std::max(max.x, box.x + box.w), std::max(max.y, box.y + box.h)};
+        cell = {std::min(cell.x, box.w), std::min(cell.y, box.h)};
+    }
+    if (min.x > max.x)
+        return;
+
+    const Vector2D size = max - min;
+    tile_index.origin = min;
+    tile_index.cols = std::clamp((int)std::ceil(size.x / cell.x), 1, MAX_INDEX_CELLS);
+    tile_index.rows = std::clamp((int)std::ceil(size.y / cell.y), 1, MAX_INDEX_CELLS);
+    tile_index.cell = {size.x / tile_index.cols, size.y / tile_index.rows};
+
+    const auto to_cell = [&](double v, double origin, double cell_size, int cells) {
+        return std::clamp((int)std::floor((v - origin) / cell_size), 0, cells - 1);
+    };
+    // Count the tiles of each bucket, turn the counts into start offsets, then fill
+    const auto for_each_cell = [&](auto&& fn) {
+        for (const auto& [id, layout] : overview_layout) {
+            const CBox& box = layout.box;
+            if (box.w <= 0 || box.h <= 0)
+                continue;
+            const int x0 = to_cell(box.x, min.x, tile_index.cell.x, tile_index.cols);
+            const int x1 = to_cell(box.x + box.w, min.x, tile_index.cell.x, tile_index.cols);
+            const int y0 = to_cell(box.y, min.y, tile_index.cell.y, tile_index.rows);
+            const int y1 = to_cell(box.y + box.h, min.y, tile_index.cell.y, tile_index.rows);
+            for (int y = y0; y <= y1; y++)
+                for (int x = x0; x <= x1; x++)
+                    fn((size_t)y * tile_index.cols + x, id);
+        }
+    };
+    const size_t bucket_count = (size_t)tile_index.cols * tile_index.rows;
+    tile_index.bucket_start.assign(bucket_count + 1, 0);
+    for_each_cell([&](size_t bucket, WORKSPACEID) { tile_index.bucket_start[bucket + 1]++; });
+    for (size_t i = 1; i <= bucket_count; i++)
+        tile_index.bucket_start[i] += tile_index.bucket_start[i - 1];
+    tile_index.bucket_tiles.resize(tile_index.bucket_start[bucket_count]);
+    // Advances each bucket's start to its end; shifted back into place below
+    for_each_cell([&](size_t bucket, WORKSPACEID id) {
+        tile_index.bucket_tiles[tile_index.bucket_start[bucket]++] = id;
+    });
+    for (size_t i = bucket_count; i > 0; i--)
+        tile_index.bucket_start[i] = tile_index.bucket_start[i - 1];
+    tile_index.bucket_start[0] = 0;
+}
+
+std::pair<int, int> HTLayoutBase::get_ws_xy(WORKSPACEID workspace_id) {
+    const HTWorkspace& layout = overview_layout[workspace_id];
+    return {layout.x, layout.y};
+}
+
+CBox HTLayoutBase::get_ws_box(WORKSPACEID workspace_id) {
+    return overview_layout[workspace_id].box;
+}
+
+WORKSPACEID HTLayoutBase::get_ws_id_from_xy(int x, int y) {
+    if (x < 0 || y < 0 || x >= tile_index.slot_cols)
+        return WORKSPACE_INVALID;
+    const size_t slot = (size_t)y * tile_index.slot_cols + x;
+    if (slot >= tile_index.slots.size())
+        return WORKSPACE_INVALID;
+    return tile_index.slots[slot];
 }
 
 CBox HTLayoutBase::get_global_window_box(PHLWINDOW window, WORKSPACEID workspace_id) {
@@ -252,7 +582,7 @@ CBox HTLayoutBase::get_global_window_box(PHLWINDOW window, WORKSPACEID workspace
 }
 
 CBox HTLayoutBase::get_global_ws_box(WORKSPACEID workspace_id) {
-    const CBox scaled_ws_box = overview_layout[workspace_id].box;
+    const CBox scaled_ws_box = get_ws_box(workspace_id);
     const Vector2D top_left = local_ws_scaled_to_global(scaled_ws_box.pos(), workspace_id);
     const Vector2D bottom_right =
         local_ws_scaled_to_global(scaled_ws_box.pos() + scaled_ws_box.size(), workspace_id);
@@ -264,7 +594,7 @@ Vector2D HTLayoutBase::global_to_local_ws_unscaled(Vector2D pos, WORKSPACEID wor
     if (monitor == nullptr)
         return {};
 
-    CBox workspace_box = overview_layout[workspace_id].box;
+    CBox workspace_box = get_ws_box(workspace_id);
     if (workspace_box.empty())
         return {};
     pos -= monitor->m_position;
@@ -290,7 +620,7 @@ Vector2D HTLayoutBase::local_ws_unscaled_to_global(Vector2D pos, WORKSPACEID wor
     if (monitor == nullptr)
         return {};
 
-    CBox workspace_box = overview_layout[workspace_id].box;
+    CBox workspace_box = get_ws_box(workspace_id);
     if (workspace_box.empty())
         return {};
     pos *= workspace_box.w / monitor->m_transformedSize.x;
@@ -6,6 +6,8 @@
 #include <hyprutils/math/Box.hpp>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "../types.hpp"
@@ -38,8 +40,45 @@ class HTLayoutBase {
         CBox box;
     };
 
+    // Flat storage for the overview layout. Entries sit in one vector that keeps its capacity,
+    // and a rebuild over the same workspaces overwrites them in place.
+    class HTLayoutStore {
+      public:
+        using Entry = std::pair<WORKSPACEID, HTWorkspace>;
+        using iterator = std::vector<Entry>::iterator;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        iterator begin() { return entries.begin(); }
+        iterator end() { return entries.end(); }
+        const_iterator begin() const { return entries.begin(); }
+        const_iterator end() const { return entries.end(); }
+        size_t size() const { return entries.size(); }
+        bool empty() const { return entries.empty(); }
+
+        iterator find(WORKSPACEID id);
+        const_iterator find(WORKSPACEID id) const;
+        // Layout of `id`, or an empty one if it isn't in the overview. Never inserts.
+        const HTWorkspace& operator[](WORKSPACEID id) const;
+
+        // Rebuild: set() every workspace between begin_update() and end_update(). The latter
+        // returns whether anything differs from the previous build.
+        void begin_update();
+        void set(WORKSPACEID id, const HTWorkspace& workspace);
+        bool end_update();
+        // Whether the last update changed a workspace or its (x, y), not just boxes
+        bool slots_changed() const { return ids_changed || positions_changed; }
+
+      private:
+        std::vector<Entry> entries;
+        std::unordered_map<WORKSPACEID, size_t> positions;
+        size_t cursor = 0;
+        bool ids_changed = false;
+        bool positions_changed = false;
+        bool changed = false;
+    };
+
     virtual CBox calculate_ws_box(int x, int y, HTViewStage stage) = 0;
-    std::unordered_map<WORKSPACEID, HTWorkspace> overview_layout;
+    HTLayoutStore overview_layout;
 
     // Warp the show/hide animations to perc (from closed to open)
     virtual void close_open_lerp(float perc) = 0;
@@ -62,21 +101,50 @@ class HTLayoutBase {
     virtual bool should_manage_mouse();
     // Called assuming that at least one overview is active (not nec on this monitor)
     virtual bool should_render_window(PHLWINDOW window);
+    // True while the overview geometry itself is moving, so every frame must be redrawn
+    virtual bool is_animating();
     // The scale the drag window should be rendered at (about the mouse cursor)
     virtual float drag_window_scale();
     // Only to be called when closed, init/reset the position in case of config/monitor change
     virtual void init_position();
-    // Populate overview_layout as if the overview was at a given stage
+    // Populate overview_layout as if the overview was at a given stage. Cheap when nothing the
+    // layout depends on has changed since the last call.
     virtual void build_overview_layout(HTViewStage stage);
+    // Force the next build_overview_layout to recompute every box (config reload, ...)
+    void invalidate_overview_layout();
 
+    // Called before the monitor renders a frame, outside of any render pass. Offscreen work
+    // (e.g. refreshing cached tiles) belongs here.
+    virtual void pre_render();
     // Render the overview
     virtual void render();
 
-    // Workspaces in the same visual order used by the keyboard jump labels.
-    std::vector<WORKSPACEID> jump_targets() const;
+    // Contents of a workspace changed (surface commit, decoration, ...)
+    virtual void damage_workspace(WORKSPACEID workspace_id);
+    // A window changed: invalidate its workspace and damage the rect it covers on its tile
+    void damage_window(PHLWINDOW window);
+    // Something drawn on every workspace of the monitor changed (layers, wallpaper)
+    virtual void damage_all_workspaces();
+
+    // Sort the windows of every tile, in one sweep, into those visible on the monitor and
+    // those whose full bounding box (border, shadow) is covered by opaque windows stacked
+    // above them (or being dragged). Windows with open popups are never covered. Call after
+    // build_overview_layout, before rendering the tiles.
+    void update_visible_windows();
+    bool is_occluded(PHLWINDOW window) const;
+    // Topmost window drawn at `pos` (global, logical) on a tile, as of the last
+    // update_visible_windows. Fully covered, dragged and closing windows are never hit.
+    PHLWINDOW window_at(Vector2D pos) const;
+    // On a tile that is on screen, and not occluded
+    bool is_window_visible(PHLWINDOW window) const;
+
+    // Workspaces in the same visual order used by the keyboard jump labels. Sorted when the
+    // layout's workspaces or their positions change, not per call.
+    const std::vector<WORKSPACEID>& jump_targets() const { return jump_order; }
     std::optional<WORKSPACEID> jump_target(size_t index) const;
 
-    // Prevent simplification from happening in the plugin, remove all clear pass objects
+    // Draw the jump labels and prevent simplification from happening in the plugin. Clears
+    // Hyprland adds per workspace are already dropped by render_workspace_original.
     void post_render();
 
     // Draw keyboard jump labels over the workspace previews.
@@ -84,7 +152,11 @@ class HTLayoutBase {
 
     PHLMONITOR get_monitor();
     WORKSPACEID get_ws_id_from_global(Vector2D pos);
-    WORKSPACEID get_ws_id_from_xy(int x, int y);
+    virtual WORKSPACEID get_ws_id_from_xy(int x, int y);
+    // Layout (x, y) of a workspace, including one the layout doesn't currently hold a tile for
+    virtual std::pair<int, int> get_ws_xy(WORKSPACEID workspace_id);
+    // Tile box of a workspace (monitor-local pixels), likewise. Empty if it has none.
+    virtual CBox get_ws_box(WORKSPACEID workspace_id);
     std::pair<int, int> get_current_ws_xy();
     CBox get_global_window_box(PHLWINDOW window, WORKSPACEID workspace_id);
     CBox get_global_ws_box(WORKSPACEID workspace_id);
@@ -93,4 +165,48 @@ class HTLayoutBase {
     Vector2D global_to_local_ws_unscaled(Vector2D pos, WORKSPACEID workspace_id);
     Vector2D local_ws_scaled_to_global(Vector2D pos, WORKSPACEID workspace_id);
     Vector2D local_ws_unscaled_to_global(Vector2D pos, WORKSPACEID workspace_id);
+
+  protected:
+    // Bumped by invalidate_overview_layout; part of what each layout compares before a rebuild
+    uint64_t layout_generation = 0;
+
+    // Rebuild the lookups used by get_ws_id_from_global, get_ws_id_from_xy and jump_targets.
+    // Call whenever overview_layout changes.
+    void index_overview_layout();
+
+    // Workspaces in jump label order; by default those of overview_layout by (y, x, id)
+    std::vector<WORKSPACEID> jump_order;
+    // Re-sort jump_order, called by index_overview_layout when the layout's slots change.
+    // Layouts that only lay out part of their workspaces keep it over all of them instead.
+    virtual void update_jump_order();
+
+  private:
+    struct HTTileIndex {
+        // Uniform grid of buckets over the tiles, each listing the tiles overlapping it. Bucket
+        // i is bucket_tiles[bucket_start[i], bucket_start[i + 1]); flat, so rebuilding on every
+        // animating frame reuses the same two buffers.
+        Vector2D origin;
+        Vector2D cell;
+        int cols = 0;
+        int rows = 0;
+        std::vector<size_t> bucket_start;
+        std::vector<WORKSPACEID> bucket_tiles;
+
+        // Workspace at each layout (x, y), row-major
+        int slot_cols = 0;
+        std::vector<WORKSPACEID> slots;
+    };
+    HTTileIndex tile_index;
+
+    struct HTWindowHit {
+        PHLWINDOWREF window;
+        // Where the window, its border and resize extents are on its tile (global, logical)
+        CBox box;
+    };
+    // Uncovered on-screen windows of every tile, topmost first within each tile
+    std::vector<HTWindowHit> window_hits;
+
+    // Identity only, never dereferenced; rebuilt by update_visible_windows every frame
+    std::unordered_set<const Desktop::View::CWindow*> occluded_windows;
+    std::unordered_set<const Desktop::View::CWindow*> visible_windows;
 };
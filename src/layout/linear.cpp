@@ -9,21 +9,29 @@
 #include <hyprland/src/animation/WorkspaceAnimationController.hpp>
 #include <hyprland/src/config/shared/workspace/WorkspaceRuleManager.hpp>
 #include <hyprland/src/layout/LayoutManager.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
-#include <hyprland/src/render/pass/BorderPassElement.hpp>
+#include <hyprland/src/render/OpenGL.hpp>
+#include <hyprland/src/render/Renderer.hpp>
 #include <hyprland/src/render/pass/RectPassElement.hpp>
+#include <hyprland/src/render/pass/TexPassElement.hpp>
 #include <hyprland/src/state/WorkspaceState.hpp>
 #include <hyprutils/math/Box.hpp>
 #include <hyprutils/utils/ScopeGuard.hpp>
-#include <ranges>
+#include <algorithm>
+#include <cmath>
 
 #include "../config.hpp"
 #include "../globals.hpp"
+#include "../pass/pass_element.hpp"
 #include "../render.hpp"
 #include "layout_base.hpp"
 
 using Hyprutils::Utils::CScopeGuard;
 
+// A backdrop that keeps being damaged (video, terminal output) is recaptured at most this often
+static constexpr auto BACKDROP_REFRESH_INTERVAL = std::chrono::milliseconds(100);
+
 HTLayoutLinear::HTLayoutLinear(VIEWID new_view_id) : HTLayoutBase(new_view_id) {
     auto &anim_tree = Config::animationTree();
     Animation::mgr()->createAnimation(
@@ -51,9 +59,21 @@ HTLayoutLinear::HTLayoutLinear(VIEWID new_view_id) : HTLayoutBase(new_view_id) {
         AVARDAMAGE_NONE
     );
 
+    backdrop_timer = makeShared<CEventLoopTimer>(
+        std::nullopt,
+        [this](SP<CEventLoopTimer> self, void* data) { damage_backdrop(); },
+        nullptr
+    );
+    g_pEventLoopManager->addTimer(backdrop_timer);
+
     init_position();
 }
 
+HTLayoutLinear::~HTLayoutLinear() {
+    if (backdrop_timer != nullptr)
+        g_pEventLoopManager->removeTimer(backdrop_timer);
+}
+
 std::string HTLayoutLinear::layout_name() {
     return "linear";
 }
@@ -62,7 +82,7 @@ void HTLayoutLinear::close_open_lerp(float perc) {
     const PHLMONITOR monitor = get_monitor();
     if (monitor == nullptr)
         return;
-    const float HEIGHT = HTConfig::value<Config::FLOAT>("linear:height") * monitor->m_scale;
+    const float HEIGHT = HTConfig::options().linear.height * monitor->m_scale;
 
     view_offset->resetAllCallbacks();
     blur_strength->resetAllCallbacks();
@@ -82,7 +102,7 @@ void HTLayoutLinear::on_show(CallbackFun on_complete) {
     if (monitor == nullptr)
         return;
 
-    const float HEIGHT = HTConfig::value<Config::FLOAT>("linear:height") * monitor->m_scale;
+    const float HEIGHT = HTConfig::options().linear.height * monitor->m_scale;
     *view_offset = HEIGHT;
     *blur_strength = 2.0;
     *dim_opacity = 0.4;
@@ -113,7 +133,7 @@ void HTLayoutLinear::on_move(WORKSPACEID old_id, WORKSPACEID new_id, CallbackFun
     if (monitor == nullptr)
         return;
 
-    const float GAP_SIZE = HTConfig::value<Config::FLOAT>("gap_size") * monitor->m_scale;
+    const float GAP_SIZE = HTConfig::options().gap_size * monitor->m_scale;
 
     const PHLWORKSPACE new_ws = State::workspaceState()->query().id(new_id).run();
     if (new_ws == nullptr)
@@ -121,9 +141,13 @@ void HTLayoutLinear::on_move(WORKSPACEID old_id, WORKSPACEID new_id, CallbackFun
 
     build_overview_layout(HT_VIEW_ANIMATING);
 
-    const float cur_screen_min_x = overview_layout[new_id].box.x - GAP_SIZE;
-    const float cur_screen_max_x =
-        overview_layout[new_id].box.x + overview_layout[new_id].box.w + GAP_SIZE;
+    // The strip only lays out tiles on screen, so place the target from its strip index
+    const long long strip_idx = strip_index(new_id);
+    if (strip_idx < 0)
+        return;
+    const CBox new_box = calculate_ws_box(strip_idx, 0, HT_VIEW_ANIMATING);
+    const float cur_screen_min_x = new_box.x - GAP_SIZE;
+    const float cur_screen_max_x = new_box.x + new_box.w + GAP_SIZE;
 
     if (cur_screen_min_x < 0) {
         *scroll_offset = scroll_offset->value() - cur_screen_min_x;
@@ -140,10 +164,11 @@ bool HTLayoutLinear::on_mouse_axis(double delta) {
     if (monitor == nullptr)
         return false;
 
-    const float GAP_SIZE = HTConfig::value<Config::FLOAT>("gap_size") * monitor->m_scale;
+    const float GAP_SIZE = HTConfig::options().gap_size * monitor->m_scale;
 
+    build_overview_layout(HT_VIEW_ANIMATING);
     const float total_ws_width =
-        (overview_layout.size() * (GAP_SIZE + calculate_ws_box(0, 0, HT_VIEW_ANIMATING).w))
+        (strip_workspaces.size() * (GAP_SIZE + calculate_ws_box(0, 0, HT_VIEW_ANIMATING).w))
         + GAP_SIZE;
 
     // Stay at 0 if not long enough
@@ -153,10 +178,10 @@ bool HTLayoutLinear::on_mouse_axis(double delta) {
     }
 
     double new_offset = scroll_offset->goal()
-        + delta * HTConfig::value<Config::FLOAT>("linear:scroll_speed") * -10.f;
+        + delta * HTConfig::options().linear.scroll_speed * -10.f;
 
     const float max_x = new_offset
-        + (overview_layout.size() * (GAP_SIZE + calculate_ws_box(0, 0, HT_VIEW_ANIMATING).w))
+        + (strip_workspaces.size() * (GAP_SIZE + calculate_ws_box(0, 0, HT_VIEW_ANIMATING).w))
         + GAP_SIZE;
 
     // Snap to left
@@ -172,7 +197,7 @@ bool HTLayoutLinear::on_mouse_axis(double delta) {
 }
 
 const float calculate_y(float size_y, float offset_value, float max_offset) {
-    const bool top = HTConfig::value<Config::INTEGER>("linear:top");
+    const bool top = HTConfig::options().linear.top;
     if (top)
         return offset_value - max_offset;
     return size_y - offset_value;
@@ -183,7 +208,7 @@ bool HTLayoutLinear::should_manage_mouse() {
     if (monitor == nullptr)
         return 1;
 
-    const float HEIGHT = HTConfig::value<Config::FLOAT>("linear:height") * monitor->m_scale;
+    const float HEIGHT = HTConfig::options().linear.height * monitor->m_scale;
 
     const Vector2D mouse_coords = g_pInputManager->getMouseCoordsInternal();
     CBox scaled_view_box = {
@@ -197,30 +222,19 @@ bool HTLayoutLinear::should_manage_mouse() {
 }
 
 bool HTLayoutLinear::should_render_window(PHLWINDOW window) {
-    bool ori_result = HTLayoutBase::should_render_window(window);
-
-    const PHLMONITOR monitor = get_monitor();
-    if (window == nullptr || monitor == nullptr)
-        return ori_result;
-
-    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
-    if (target != nullptr && window == target->window())
-        return false;
-
+    // The big workspace fills the monitor whatever its strip tile's position
     if (rendering_standard_ws)
-        return ori_result;
+        return HTLayoutBase::should_render_window(window);
 
-    PHLWORKSPACE workspace = window->m_workspace;
-    if (workspace == nullptr)
-        return false;
-
-    CBox window_box = get_global_window_box(window, window->workspaceID());
-    if (window_box.empty())
-        return false;
-    if (window_box.intersection(monitor->logicalBox()).empty())
+    // Worked out for every window at once by update_visible_windows
+    if (!is_window_visible(window))
         return false;
+    return HTLayoutBase::should_render_window(window);
+}
 
-    return ori_result;
+bool HTLayoutLinear::is_animating() {
+    return scroll_offset->isBeingAnimated() || view_offset->isBeingAnimated()
+        || blur_strength->isBeingAnimated() || dim_opacity->isBeingAnimated();
 }
 
 float HTLayoutLinear::drag_window_scale() {
@@ -250,8 +264,8 @@ CBox HTLayoutLinear::calculate_ws_box(int x, int y, HTViewStage stage) {
     if (monitor->m_transformedSize.x < 1 || monitor->m_transformedSize.y < 1)
         return {};
 
-    const float HEIGHT = HTConfig::value<Config::FLOAT>("linear:height") * monitor->m_scale;
-    const float GAP_SIZE = HTConfig::value<Config::FLOAT>("gap_size") * monitor->m_scale;
+    const float HEIGHT = HTConfig::options().linear.height * monitor->m_scale;
+    const float GAP_SIZE = HTConfig::options().gap_size * monitor->m_scale;
 
     if (HEIGHT < 0 || HEIGHT > monitor->m_transformedSize.y)
         return {};
@@ -278,29 +292,211 @@ void HTLayoutLinear::build_overview_layout(HTViewStage stage) {
     if (monitor == nullptr)
         return;
 
-    overview_layout.clear();
+    // The strip only changes with the workspaces, which the manager indexes from events
+    const bool workspaces_changed = strip_generation != ht_manager->workspaces_generation;
+    if (workspaces_changed) {
+        strip_generation = ht_manager->workspaces_generation;
+        // Reuses the buffer of the last build
+        strip_workspaces = ht_manager->monitor_workspaces(monitor->m_id);
+
+        WORKSPACEID big_id = strip_workspaces.empty() ? 1 : strip_workspaces.back();
+        while (State::workspaceState()->query().id(big_id).run() != nullptr)
+            big_id++;
+        strip_workspaces.push_back(big_id);
+        jump_order = strip_workspaces;
+    }
 
-    std::vector<WORKSPACEID> monitor_workspaces;
-    for (PHLWORKSPACE workspace : State::workspaceState()->workspacesCopy()) {
-        if (workspace == nullptr)
-            continue;
-        if (workspace->m_monitor != monitor)
-            continue;
-        if (workspace->m_isSpecialWorkspace)
-            continue;
-        monitor_workspaces.push_back(workspace->m_id);
+    // Boxes only depend on these and the workspace set (and the config, which bumps the
+    // generation)
+    const HTLayoutInputs inputs {
+        .stage = stage,
+        .scroll_offset = scroll_offset->value(),
+        .view_offset = view_offset->value(),
+        .monitor_size = monitor->m_transformedSize,
+        .monitor_scale = monitor->m_scale,
+        .generation = layout_generation,
+    };
+    if (!workspaces_changed && built_inputs == inputs)
+        return;
+    built_inputs = inputs;
+
+    // Only the tiles crossing the monitor are laid out. Tiles are evenly spaced, so that range
+    // follows from the first tile's box, plus at most one tile of slack on either side.
+    const long long count = strip_workspaces.size();
+    const CBox first_box = calculate_ws_box(0, 0, stage);
+    const double pitch = first_box.w + HTConfig::options().gap_size * monitor->m_scale;
+    long long first = 0;
+    long long last = count;
+    if (first_box.w > 0 && pitch > 0) {
+        first = std::clamp<long long>(std::floor(-(first_box.x + first_box.w) / pitch), 0, count);
+        last = std::clamp<long long>(
+            std::ceil((monitor->m_transformedSize.x - first_box.x) / pitch) + 1,
+            first,
+            count
+        );
+    }
+
+    overview_layout.begin_update();
+    for (long long x = first; x < last; x++) {
+        const CBox ws_box = calculate_ws_box(x, 0, stage);
+        overview_layout.set(strip_workspaces[x], {(int)x, 0, ws_box});
+    }
+    if (overview_layout.end_update())
+        index_overview_layout();
+}
+
+void HTLayoutLinear::update_jump_order() {
+    ;
+}
+
+long long HTLayoutLinear::strip_index(WORKSPACEID workspace_id) const {
+    // Sorted: the monitor's workspaces by id, then the new one past the highest id
+    const auto it =
+        std::lower_bound(strip_workspaces.begin(), strip_workspaces.end(), workspace_id);
+    if (it == strip_workspaces.end() || *it != workspace_id)
+        return -1;
+    return it - strip_workspaces.begin();
+}
+
+std::pair<int, int> HTLayoutLinear::get_ws_xy(WORKSPACEID workspace_id) {
+    return {std::max<long long>(strip_index(workspace_id), 0), 0};
+}
+
+CBox HTLayoutLinear::get_ws_box(WORKSPACEID workspace_id) {
+    if (const auto it = overview_layout.find(workspace_id); it != overview_layout.end())
+        return it->second.box;
+    const long long idx = strip_index(workspace_id);
+    if (idx < 0)
+        return {};
+    return calculate_ws_box(
+        idx,
+        0,
+        built_inputs.has_value() ? built_inputs->stage : HT_VIEW_ANIMATING
+    );
+}
+
+WORKSPACEID HTLayoutLinear::get_ws_id_from_xy(int x, int y) {
+    if (y != 0 || x < 0 || x >= (long long)strip_workspaces.size())
+        return WORKSPACE_INVALID;
+    return strip_workspaces[x];
+}
+
+bool HTLayoutLinear::backdrop_usable() {
+    const PHLMONITOR monitor = get_monitor();
+    if (monitor == nullptr || monitor->m_activeWorkspace == nullptr)
+        return false;
+    return backdrop_ws == monitor->m_activeWorkspace->m_id && backdrop_fb.getTexture() != nullptr
+        && !view_offset->isBeingAnimated() && !blur_strength->isBeingAnimated()
+        && !dim_opacity->isBeingAnimated();
+}
+
+// Render the big workspace with the blur/dim on top, at their current values
+void HTLayoutLinear::add_backdrop_pass(const CBox& mon_box) {
+    const PHLMONITOR monitor = get_monitor();
+    if (monitor == nullptr || monitor->m_activeWorkspace == nullptr)
+        return;
+
+    rendering_standard_ws = true;
+    // Render the current workspace on the screen
+    render_workspace_original(monitor, monitor->m_activeWorkspace, Time::steadyNow(), mon_box);
+    rendering_standard_ws = false;
+
+    // add blur/dim over the original workspace
+    CRectPassElement::SRectData blur_data;
+    blur_data.color = CHyprColor(0, 0, 0, dim_opacity->value());
+    blur_data.box = mon_box;
+    blur_data.blur = (bool)HTConfig::options().linear.blur;
+    blur_data.blurA = blur_strength->value();
+    g_pHyprRenderer->m_renderPass.add(makeUnique<CRectPassElement>(blur_data));
+}
+
+void HTLayoutLinear::damage_workspace(WORKSPACEID workspace_id) {
+    if (workspace_id == backdrop_ws)
+        backdrop_dirty = true;
+}
+
+void HTLayoutLinear::damage_all_workspaces() {
+    backdrop_dirty = true;
+}
+
+void HTLayoutLinear::damage_backdrop() {
+    const PHLMONITOR monitor = get_monitor();
+    if (monitor == nullptr)
+        return;
+
+    const float HEIGHT = HTConfig::options().linear.height * monitor->m_scale;
+    CBox strip_box = {
+        Vector2D {0.f, calculate_y(monitor->m_transformedSize.y, view_offset->value(), HEIGHT)},
+        {(float)monitor->m_transformedSize.x, (float)HEIGHT}
+    };
+    strip_box.scale(1 / monitor->m_scale).translate(monitor->m_position);
+
+    CRegion damage {monitor->logicalBox()};
+    damage.subtract(strip_box);
+    g_pHyprRenderer->damageRegion(damage);
+}
+
+// Capture the blurred backdrop once the open animation has settled (blur and dim at their
+// target values), and again whenever the big workspace is damaged, no sooner than
+// BACKDROP_REFRESH_INTERVAL after the last capture. While opening, closing or after a switch,
+// the backdrop is rendered live.
+void HTLayoutLinear::pre_render() {
+    const PHTVIEW par_view = ht_manager->get_view_from_id(view_id);
+    if (par_view == nullptr)
+        return;
+    const PHLMONITOR monitor = par_view->get_monitor();
+    if (monitor == nullptr || monitor->m_activeWorkspace == nullptr)
+        return;
+
+    if (!par_view->active) {
+        if (backdrop_ws != WORKSPACE_INVALID) {
+            backdrop_fb.release();
+            backdrop_ws = WORKSPACE_INVALID;
+        }
+        backdrop_dirty = true;
+        return;
     }
-    std::sort(monitor_workspaces.begin(), monitor_workspaces.end());
 
-    WORKSPACEID big_id = monitor_workspaces.back();
-    while (State::workspaceState()->query().id(big_id).run() != nullptr)
-        big_id++;
-    monitor_workspaces.push_back(big_id);
+    if (par_view->closing || view_offset->isBeingAnimated() || blur_strength->isBeingAnimated()
+        || dim_opacity->isBeingAnimated())
+        return;
+
+    if (backdrop_ws != monitor->m_activeWorkspace->m_id)
+        backdrop_dirty = true;
+    if (!backdrop_dirty)
+        return;
 
-    for (const auto& [x, ws_id] : monitor_workspaces | std::views::enumerate) {
-        CBox ws_box = calculate_ws_box(x, 0, stage);
-        overview_layout[ws_id] = {x, 0, ws_box};
+    const auto now = Time::steadyNow();
+    const auto due_at = backdrop_captured_at + BACKDROP_REFRESH_INTERVAL;
+    if (backdrop_ws == monitor->m_activeWorkspace->m_id && now < due_at) {
+        backdrop_timer->updateTimeout(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(due_at - now)
+        );
+        return;
     }
+
+    if (backdrop_fb.m_size != monitor->m_pixelSize) {
+        backdrop_fb.release();
+        backdrop_fb.alloc(monitor->m_pixelSize.x, monitor->m_pixelSize.y);
+    }
+
+    build_overview_layout(HT_VIEW_ANIMATING);
+    update_visible_windows();
+
+    CRegion fake_damage {0, 0, INT16_MAX, INT16_MAX};
+    g_pHyprRenderer->makeEGLCurrent();
+    g_pHyprRenderer->beginRender(monitor, fake_damage, RENDER_MODE_FULL_FAKE, nullptr, &backdrop_fb);
+    g_pHyprOpenGL->clear(CHyprColor {0, 0, 0, 1.0});
+    add_backdrop_pass({{0, 0}, monitor->m_pixelSize});
+    g_pHyprRenderer->endRender();
+
+    backdrop_ws = monitor->m_activeWorkspace->m_id;
+    backdrop_dirty = false;
+    backdrop_captured_at = now;
+
+    // The blur spreads the damage that triggered this over the whole backdrop, but the strip
+    // covers part of it
+    damage_backdrop();
 }
 
 void HTLayoutLinear::render() {
@@ -320,79 +516,46 @@ void HTLayoutLinear::render() {
     auto* const ACTIVECOL = (Config::CGradientValueData*)(PACTIVECOL.ptr());
     auto* const INACTIVECOL = (Config::CGradientValueData*)(PINACTIVECOL.ptr());
 
-    const float BORDERSIZE = HTConfig::value<Config::FLOAT>("border_size");
-    const float HEIGHT = HTConfig::value<Config::FLOAT>("linear:height") * monitor->m_scale;
+    const float BORDERSIZE = HTConfig::options().border_size;
+    const float HEIGHT = HTConfig::options().linear.height * monitor->m_scale;
 
     const auto time = Time::steadyNow();
 
-
-    g_pHyprRenderer->damageMonitor(monitor);
-    g_pHyprRenderer->m_renderData.pMonitor->m_blurFBShouldRender = true;
-
-    // Do a dance with active workspaces: Hyprland will only properly render the
-    // current active one so make the workspace active before rendering it, etc
-    const PHLWORKSPACE start_workspace = monitor->m_activeWorkspace;
-    Animation::Workspace::startAnimation(
-        start_workspace,
-        Animation::Workspace::ANIMATION_TYPE_OUT,
-        false,
-        true
-    );
-    start_workspace->m_visible = false;
-
+    // The big workspace is the monitor's active one, so Hyprland renders it as is.
     const PHLWORKSPACE big_ws = monitor->m_activeWorkspace;
-
-    rendering_standard_ws = true;
-    monitor->m_activeWorkspace = big_ws;
-    Animation::Workspace::startAnimation(
-        start_workspace,
-        Animation::Workspace::ANIMATION_TYPE_IN,
-        false,
-        true
-    );
-    big_ws->m_visible = true;
+    if (big_ws == nullptr)
+        return;
 
     // use pixel size for geometry
     CBox mon_box = {{0, 0}, monitor->m_pixelSize};
-    // Render the current workspace on the screen
-    ((render_workspace_t)(render_workspace_hook->m_original))(
-        g_pHyprRenderer.get(),
-        monitor,
-        big_ws,
-        time,
-        mon_box
-    );
-
-    // add blur/dim over the original workspace
-    CRectPassElement::SRectData blur_data;
-    blur_data.color = CHyprColor(0, 0, 0, dim_opacity->value());
-    blur_data.box = mon_box;
-    blur_data.blur = (bool)HTConfig::value<Config::INTEGER>("linear:blur");
-    blur_data.blurA = blur_strength->value();
-    g_pHyprRenderer->m_renderPass.add(makeUnique<CRectPassElement>(blur_data));
-
-    Animation::Workspace::startAnimation(
-        start_workspace,
-        Animation::Workspace::ANIMATION_TYPE_OUT,
-        false,
-        true
-    );
-    big_ws->m_visible = false;
-    rendering_standard_ws = false;
+    if (backdrop_usable()) {
+        CTexPassElement::SRenderData data;
+        data.tex = backdrop_fb.getTexture();
+        data.box = mon_box;
+        g_pHyprRenderer->m_renderPass.add(makeUnique<CTexPassElement>(std::move(data)));
+    } else {
+        g_pHyprRenderer->m_renderData.pMonitor->m_blurFBShouldRender = true;
+        add_backdrop_pass(mon_box);
+    }
 
     CBox view_box = {
         {0.f, calculate_y(monitor->m_transformedSize.y, view_offset->value(), HEIGHT)},
         {(float)monitor->m_transformedSize.x, (float)HEIGHT}
     };
 
-    CRectPassElement::SRectData data;
-    data.color = CHyprColor {HTConfig::value<Config::INTEGER>("bg_color")}.stripA();
-    data.box = view_box;
-    g_pHyprRenderer->m_renderPass.add(makeUnique<CRectPassElement>(data));
+    // Strip background and every tile border go out as one pass element
+    auto strip = makeUnique<HTBatchPassElement>();
+    strip->rects.push_back({
+        .box = view_box,
+        .color = CHyprColor {HTConfig::options().bg_color}.stripA(),
+    });
 
     build_overview_layout(HT_VIEW_ANIMATING);
+    update_visible_windows();
 
     CBox global_mon_box = {monitor->m_position, monitor->m_transformedSize};
+    std::vector<std::pair<PHLWORKSPACE, CBox>> strip_tiles;
+    bool needs_swap = false;
     for (const auto& [ws_id, ws_layout] : overview_layout) {
         // Could be nullptr, in which we render only layers
         const PHLWORKSPACE workspace = State::workspaceState()->query().id(ws_id).run();
@@ -400,45 +563,47 @@ void HTLayoutLinear::render() {
         CBox global_box = {ws_layout.box.pos() + monitor->m_position, ws_layout.box.size()};
         if (global_box.intersection(global_mon_box).empty())
             continue;
+        strip_tiles.emplace_back(workspace, ws_layout.box);
+        needs_swap = needs_swap || !can_render_workspace_direct(monitor, workspace);
+        strip->borders.push_back({
+            .box = ws_layout.box,
+            .grad = workspace == big_ws ? *ACTIVECOL : *INACTIVECOL,
+            .border_size = BORDERSIZE,
+        });
+    }
+    g_pHyprRenderer->m_renderPass.add(std::move(strip));
+
+    // Hyprland will only properly render the current active workspace. Strip workspaces that
+    // can't be drawn directly are swapped in as the active one while they render, which needs
+    // the big workspace hidden (so its windows don't show up in them) until the end.
+    const PHLWORKSPACE start_workspace = big_ws;
+    if (needs_swap) {
+        Animation::Workspace::startAnimation(
+            start_workspace,
+            Animation::Workspace::ANIMATION_TYPE_OUT,
+            false,
+            true
+        );
+        start_workspace->m_visible = false;
+    }
 
-        const Config::CGradientValueData border_col = workspace == big_ws ? *ACTIVECOL : *INACTIVECOL;
-        CBox border_box = ws_layout.box;
-
-        CBorderPassElement::SBorderData data;
-        data.box = border_box;
-        data.grad1 = border_col;
-        data.borderSize = BORDERSIZE;
-        g_pHyprRenderer->m_renderPass.add(makeUnique<CBorderPassElement>(data));
-
-        render_workspace_at_box(monitor, workspace, time, ws_layout.box);
+    for (const auto& [workspace, box] : strip_tiles)
+        render_workspace_at_box(monitor, workspace, time, box);
+
+    if (needs_swap) {
+        monitor->m_activeWorkspace = start_workspace;
+        Animation::Workspace::startAnimation(
+            start_workspace,
+            Animation::Workspace::ANIMATION_TYPE_IN,
+            false,
+            true
+        );
+        start_workspace->m_visible = true;
     }
 
-    monitor->m_activeWorkspace = start_workspace;
-    Animation::Workspace::startAnimation(
-        start_workspace,
-        Animation::Workspace::ANIMATION_TYPE_IN,
-        false,
-        true
-    );
-    start_workspace->m_visible = true;
+    if (is_animating())
+        g_pHyprRenderer->damageMonitor(monitor);
 
     // Render dragged window at mouse cursor
-    const PHTVIEW cursor_view = ht_manager->get_view_from_cursor();
-    if (cursor_view == nullptr)
-        return;
-
-    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
-    if (target == nullptr)
-        return;
-
-    const PHLWINDOW dragged_window = target->window();
-    if (dragged_window == nullptr)
-        return;
-    const Vector2D mouse_coords = g_pInputManager->getMouseCoordsInternal();
-    const CBox window_box = dragged_window->getWindowMainSurfaceBox()
-                                .translate(-mouse_coords)
-                                .scale(cursor_view->layout->drag_window_scale())
-                                .translate(mouse_coords);
-    if (!window_box.intersection(monitor->logicalBox()).empty())
-        render_window_at_box(dragged_window, monitor, time, window_box);
+    ht_manager->render_drag_window(monitor, time);
 }
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <hyprland/src/helpers/time/Time.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopTimer.hpp>
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <optional>
+#include <vector>
+
 #include "../types.hpp"
 #include "layout_base.hpp"
 
@@ -12,9 +18,47 @@ class HTLayoutLinear: public HTLayoutBase {
 
     bool rendering_standard_ws;
 
+    // Inputs of the last build_overview_layout; an unchanged layout is not rebuilt
+    struct HTLayoutInputs {
+        HTViewStage stage;
+        float scroll_offset;
+        float view_offset;
+        Vector2D monitor_size;
+        double monitor_scale;
+        uint64_t generation;
+
+        bool operator==(const HTLayoutInputs&) const = default;
+    };
+    std::optional<HTLayoutInputs> built_inputs;
+    // Workspaces of the strip in order, and the HTManager::workspaces_generation they are from
+    std::vector<WORKSPACEID> strip_workspaces;
+    uint64_t strip_generation = 0;
+
+    // The big workspace, blurred and dimmed at the settled open values. Captured once the
+    // open animation ends, recaptured when that workspace is damaged, at most once per
+    // backdrop refresh interval; the last capture is shown in between.
+    CFramebuffer backdrop_fb;
+    WORKSPACEID backdrop_ws = WORKSPACE_INVALID;
+    bool backdrop_dirty = true;
+    Time::steady_tp backdrop_captured_at;
+    // Fires when a recapture held back by the interval becomes due
+    SP<CEventLoopTimer> backdrop_timer;
+
+    // Position of a workspace along the strip, or -1
+    long long strip_index(WORKSPACEID workspace_id) const;
+
+    // The whole strip, not just the tiles laid out, so a workspace keeps its key while the
+    // strip scrolls. Kept by build_overview_layout.
+    virtual void update_jump_order();
+
+    bool backdrop_usable();
+    void add_backdrop_pass(const CBox& mon_box);
+    // Damage the part of the monitor showing the backdrop, i.e. everything but the strip
+    void damage_backdrop();
+
   public:
     HTLayoutLinear(VIEWID view_id);
-    virtual ~HTLayoutLinear() = default;
+    virtual ~HTLayoutLinear();
 
     virtual std::string layout_name();
 
@@ -27,10 +71,20 @@ class HTLayoutLinear: public HTLayoutBase {
 
     virtual bool on_mouse_axis(double delta);
 
+    virtual std::pair<int, int> get_ws_xy(WORKSPACEID workspace_id);
+    // Off-screen strip workspaces have no tile in overview_layout; their box is computed
+    virtual CBox get_ws_box(WORKSPACEID workspace_id);
+    virtual WORKSPACEID get_ws_id_from_xy(int x, int y);
+
     virtual bool should_manage_mouse();
     virtual bool should_render_window(PHLWINDOW window);
+    virtual bool is_animating();
     virtual float drag_window_scale();
     virtual void init_position();
     virtual void build_overview_layout(HTViewStage stage);
+    virtual void pre_render();
     virtual void render();
+
+    virtual void damage_workspace(WORKSPACEID workspace_id);
+    virtual void damage_all_workspaces();
 };
@@ -6,6 +6,9 @@
 #include <hyprland/src/SharedDefs.hpp>
 #include <hyprland/src/config/shared/actions/ConfigActions.hpp>
 #include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/desktop/view/LayerSurface.hpp>
+#include <hyprland/src/desktop/view/Popup.hpp>
+#include <hyprland/src/desktop/view/Subsurface.hpp>
 #include <hyprland/src/devices/IKeyboard.hpp>
 #include <hyprland/src/output/Monitor.hpp>
 #include <hyprland/src/macros.hpp>
@@ -14,6 +17,7 @@
 #include <hyprland/src/pointer/PointerManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
 #include <hyprland/src/plugins/HookSystem.hpp>
+#include <hyprland/src/protocols/core/Compositor.hpp>
 #include <hyprland/src/plugins/PluginAPI.hpp>
 #include <hyprland/src/plugins/PluginSystem.hpp>
 #include <hyprland/src/render/OpenGL.hpp>
@@ -137,8 +141,8 @@ static SDispatchResult change_layer(std::string arg, bool move_window) {
     if (cursor_view->layout->layout_name() != "grid")
         return {.success = false, .error = "layers are only supported in grid layout"};
 
-    const int LAYERS = HTConfig::value<Config::INTEGER>("grid:layers");
-    const int LOOP_LAYERS = HTConfig::value<Config::INTEGER>("grid:loop_layers");
+    const int LAYERS = HTConfig::options().grid.layers;
+    const int LOOP_LAYERS = HTConfig::options().grid.loop_layers;
     const int original_layer = cursor_view->layout->layer;
 
     int resulting_layer = original_layer;
@@ -279,8 +283,10 @@ static void hook_render_workspace(
                                   ->m_original))(thisptr, monitor, workspace, now, geometry);
         return;
     }
+    // Only monitors whose own overview is open (or animating), or that show a window dragged
+    // out of an overview, leave Hyprland's native path
     const PHTVIEW view = ht_manager->get_view_from_monitor(monitor);
-    if ((view != nullptr && view->navigating) || ht_manager->has_active_view()) {
+    if (view != nullptr && ht_manager->overview_renders(monitor)) {
         view->layout->render();
     } else {
         ((render_workspace_t)(render_workspace_hook
@@ -301,20 +307,15 @@ static bool render_modif_scaled() {
     return render_modif.enabled && !render_modif.modifs.empty();
 }
 
-// True only while hyprtasking is itself driving a scaled render (overview open, or a
-// view animating open/closed on this monitor). Native renderModif paths -- workspace
+// True only while hyprtasking is itself driving a scaled render (this monitor's overview
+// open, or animating open/closed). Native renderModif paths -- workspace
 // slides, special workspace, etc. -- are left on Hyprland's normal rendering so the
-// fixes below never perturb them.
+// fixes below never perturb them. Called for every surface drawn, so it reads the
+// state snapshotted at the start of the monitor's frame.
 static bool ht_scaled_render() {
     if (ht_manager == nullptr || !render_modif_scaled())
         return false;
-    if (ht_manager->has_active_view())
-        return true;
-    const auto monitor = g_pHyprRenderer->m_renderData.pMonitor.lock();
-    if (monitor == nullptr)
-        return false;
-    const PHTVIEW view = ht_manager->get_view_from_monitor(monitor);
-    return view != nullptr && view->navigating;
+    return ht_manager->overview_renders(g_pHyprRenderer->m_renderData.pMonitor.lock());
 }
 
 // Hyprland applies the active renderModif to a texture's quad, but NOT to any of the
@@ -450,7 +451,7 @@ static bool hook_blur_optimizations(void* thisptr, PHLLS pLayer, PHLWINDOW pWind
 static bool hook_should_render_window(void* thisptr, PHLWINDOW window, PHLMONITOR monitor) {
     bool ori_result =
         ((should_render_window_t)(should_render_window_hook->m_original))(thisptr, window, monitor);
-    if (ht_manager == nullptr || !ht_manager->has_active_view())
+    if (ht_manager == nullptr || !ht_manager->overview_renders(monitor))
         return ori_result;
     const PHTVIEW view = ht_manager->get_view_from_monitor(monitor);
     if (view == nullptr)
@@ -459,9 +460,11 @@ static bool hook_should_render_window(void* thisptr, PHLWINDOW window, PHLMONITO
 }
 
 static uint32_t hook_is_solitary_blocked(void* thisptr, bool full) {
-    // No manager/view for the cursor monitor (e.g. during teardown): defer to
-    // Hyprland. Falling through here would dereference a null view.
-    PHTVIEW view = ht_manager == nullptr ? nullptr : ht_manager->get_view_from_cursor();
+    // thisptr is the monitor being evaluated, whose id is also its view's id. No manager or
+    // view (e.g. during teardown): defer to Hyprland.
+    const auto monitor = (Monitor::CMonitor*)thisptr;
+    const PHTVIEW view =
+        ht_manager == nullptr ? nullptr : ht_manager->get_view_from_id(monitor->m_id);
     if (view == nullptr)
         return (*(origIsSolitaryBlocked)is_solitary_blocked_hook->m_original)(thisptr, full);
 
@@ -471,6 +474,69 @@ static uint32_t hook_is_solitary_blocked(void* thisptr, bool full) {
     return (*(origIsSolitaryBlocked)is_solitary_blocked_hook->m_original)(thisptr, full);
 }
 
+typedef void (*damage_surface_t)(
+    void* thisptr,
+    SP<CWLSurfaceResource> surface,
+    double x,
+    double y,
+    double scale
+);
+typedef void (*damage_window_t)(void* thisptr, PHLWINDOW window, bool forceFull);
+
+// Cached overview tiles are only redrawn when their workspace is damaged. Hyprland's own
+// damage is in unscaled desktop coordinates and is passed through untouched; we only
+// additionally note which workspace (or, for layer surfaces, which monitor) changed.
+static void hook_damage_surface(
+    void* thisptr,
+    SP<CWLSurfaceResource> surface,
+    double x,
+    double y,
+    double scale
+) {
+    ((damage_surface_t)(damage_surface_hook->m_original))(thisptr, surface, x, y, scale);
+    if (ht_manager == nullptr || surface == nullptr || !ht_manager->has_active_view())
+        return;
+
+    const auto hl_surface = Desktop::View::CWLSurface::fromResource(surface);
+    if (hl_surface == nullptr)
+        return;
+    auto view = hl_surface->view();
+
+    // Subsurfaces and popups belong to the window (or layer) they are attached to
+    if (const auto subsurface = dynamicPointerCast<Desktop::View::CSubsurface>(view)) {
+        if (const PHLWINDOW window = subsurface->m_windowParent.lock()) {
+            ht_manager->on_window_commit(window);
+            return;
+        }
+        const auto popup = subsurface->m_popupParent.lock();
+        if (popup == nullptr)
+            return;
+        view = popup;
+    }
+    if (const auto popup = dynamicPointerCast<Desktop::View::CPopup>(view)) {
+        if (const PHLWINDOW window = popup->m_windowOwner.lock()) {
+            ht_manager->on_window_commit(window);
+            return;
+        }
+        view = popup->m_layerOwner.lock();
+    }
+
+    if (const PHLWINDOW window = dynamicPointerCast<Desktop::View::CWindow>(view)) {
+        ht_manager->on_window_commit(window);
+        return;
+    }
+    // Layer surfaces show up on every tile of their monitor
+    if (const PHLLS layer = dynamicPointerCast<Desktop::View::CLayerSurface>(view))
+        ht_manager->on_monitor_damage(layer->m_monitor.lock());
+}
+
+static void hook_damage_window(void* thisptr, PHLWINDOW window, bool forceFull) {
+    ((damage_window_t)(damage_window_hook->m_original))(thisptr, window, forceFull);
+    if (ht_manager == nullptr || !ht_manager->has_active_view())
+        return;
+    ht_manager->on_window_damage(window);
+}
+
 static void on_mouse_button(IPointer::SButtonEvent e, Event::SCallbackInfo& info) {
     if (ht_manager == nullptr)
         return;
@@ -481,8 +547,8 @@ static void on_mouse_button(IPointer::SButtonEvent e, Event::SCallbackInfo& info
 
     const bool pressed = e.state == WL_POINTER_BUTTON_STATE_PRESSED;
 
-    const unsigned int drag_button = HTConfig::value<Config::INTEGER>("drag_button");
-    const unsigned int select_button = HTConfig::value<Config::INTEGER>("select_button");
+    const unsigned int drag_button = HTConfig::options().drag_button;
+    const unsigned int select_button = HTConfig::options().select_button;
 
     if (pressed && e.button == drag_button) {
         info.cancelled = ht_manager->start_window_drag();
@@ -535,6 +601,12 @@ static void cancel_event(Event::SCallbackInfo& info) {
     info.cancelled = true;
 }
 
+static void on_render_pre(PHLMONITOR monitor) {
+    if (ht_manager == nullptr)
+        return;
+    ht_manager->on_render_pre(monitor);
+}
+
 static void register_monitors() {
     if (ht_manager == nullptr)
         return;
@@ -549,7 +621,7 @@ static void register_monitors() {
                 view->layout->init_position();
             continue;
         }
-        ht_manager->views.push_back(makeShared<HTView>(monitor->m_id));
+        ht_manager->add_view(makeShared<HTView>(monitor->m_id));
 
         Log::logger->log(
             LOG,
@@ -569,7 +641,26 @@ static void on_monitor_removed(PHLMONITOR monitor) {
     ht_manager->refresh_all_grid_caches();
 }
 
+static void on_workspace_created(PHLWORKSPACE workspace) {
+    if (ht_manager == nullptr)
+        return;
+    ht_manager->on_workspace_created(workspace);
+}
+
+static void on_workspace_removed(PHLWORKSPACE workspace) {
+    if (ht_manager == nullptr)
+        return;
+    ht_manager->on_workspace_removed(workspace);
+}
+
+static void on_workspace_moved(PHLWORKSPACE workspace, PHLMONITOR monitor) {
+    if (ht_manager == nullptr)
+        return;
+    ht_manager->on_workspace_moved(workspace, monitor);
+}
+
 static void on_config_reloaded() {
+    HTConfig::refresh();
     if (ht_manager == nullptr)
         return;
 
@@ -577,13 +668,14 @@ static void on_config_reloaded() {
     for (PHTVIEW& view : ht_manager->views) {
         if (view == nullptr)
             continue;
-        const Config::STRING new_layout = HTConfig::value<Config::STRING>("layout");
-        if (HTConfig::value<Config::INTEGER>("close_overview_on_reload")
+        const Config::STRING new_layout = HTConfig::options().layout;
+        if (HTConfig::options().close_overview_on_reload
             || view->layout->layout_name() != new_layout) {
             Log::logger->log(LOG, "[Hyprtasking] Closing overview on config reload");
             view->hide(false);
             view->change_layout(new_layout);
         }
+        view->layout->invalidate_overview_layout();
     }
 
     ht_manager->refresh_all_grid_caches();
@@ -686,6 +778,31 @@ static void init_functions() {
     Log::logger->log(LOG, "[Hyprtasking] Attempting hook {}", FNS4[0].signature);
     success = is_solitary_blocked_hook->hook() && success;
 
+    // Damage hooks, used to invalidate cached overview tiles. Mangled like renderWindow, as
+    // other functions share these names and a hook on one with another signature would
+    // corrupt the call.
+    static auto FNS5 = HyprlandAPI::findFunctionsByName(
+        PHANDLE,
+        "_ZN6Render13IHyprRenderer13damageSurfaceEN9Hyprutils6Memory14CSharedPointerI18CWLSurfaceResourceEEddd"
+    );
+    if (FNS5.empty())
+        fail_exit("No damageSurface");
+    damage_surface_hook =
+        HyprlandAPI::createFunctionHook(PHANDLE, FNS5[0].address, (void*)hook_damage_surface);
+    Log::logger->log(LOG, "[Hyprtasking] Attempting hook {}", FNS5[0].signature);
+    success = damage_surface_hook->hook() && success;
+
+    static auto FNS6 = HyprlandAPI::findFunctionsByName(
+        PHANDLE,
+        "_ZN6Render13IHyprRenderer12damageWindowEN9Hyprutils6Memory14CSharedPointerIN7Desktop4View7CWindowEEEb"
+    );
+    if (FNS6.empty())
+        fail_exit("No damageWindow");
+    damage_window_hook =
+        HyprlandAPI::createFunctionHook(PHANDLE, FNS6[0].address, (void*)hook_damage_window);
+    Log::logger->log(LOG, "[Hyprtasking] Attempting hook {}", FNS6[0].signature);
+    success = damage_window_hook->hook() && success;
+
     if (!success)
         fail_exit("Failed initializing hooks");
 }
@@ -710,6 +827,12 @@ static void register_callbacks() {
     static auto P10 = Event::bus()->m_events.config.reloaded.listen(on_config_reloaded);
     static auto P11 = Event::bus()->m_events.monitor.added.listen(register_monitors);
     static auto P12 = Event::bus()->m_events.monitor.removed.listen(on_monitor_removed);
+
+    static auto P13 = Event::bus()->m_events.render.pre.listen(on_render_pre);
+
+    static auto P14 = Event::bus()->m_events.workspace.created.listen(on_workspace_created);
+    static auto P15 = Event::bus()->m_events.workspace.removed.listen(on_workspace_removed);
+    static auto P16 = Event::bus()->m_events.workspace.moveToMonitor.listen(on_workspace_moved);
 }
 
 
@@ -750,48 +873,12 @@ static void add_dispatchers() {
 } while (0)
 
 static void init_config() {
-    addConfigValue(CStringValue, "layout", "layout", "grid");
-
-    // general
-    addConfigValue(CIntValue, "bg_color", "background color", 0x000000FF);
-    addConfigValue(CFloatValue, "gap_size", "gap size", 8.f);
-
-    addConfigValue(CFloatValue, "border_size", "border size", 4.f);
-    addConfigValue(CIntValue, "exit_on_hovered", "exit on hovered", 0);
-    addConfigValue(CIntValue, "warp_on_move_window", "warp on move window", 1);
-    addConfigValue(CIntValue, "close_overview_on_reload", "close overview on reload", 1);
-
-    addConfigValue(CIntValue, "drag_button", "drag button", BTN_LEFT);
-    addConfigValue(CIntValue, "select_button", "select button", BTN_RIGHT);
-
-    // keyboard workspace jump labels
-    addConfigValue(CIntValue, "jump:enabled", "enable keyboard workspace jump labels", 0);
-    addConfigValue(CIntValue, "jump:label_color", "jump label color", 0xFFFFFFFF);
-    addConfigValue(CIntValue, "jump:label_background", "jump label background", 0x000000CC);
-    addConfigValue(CIntValue, "jump:label_size", "jump label font size", 32);
-
-    // swipe
-    addConfigValue(CIntValue, "gestures:enabled", "enabled", 1);
-    addConfigValue(CIntValue, "gestures:move_fingers", "move fingers", 3);
-    addConfigValue(CFloatValue, "gestures:move_distance", "move distance", 300.0);
-    addConfigValue(CIntValue, "gestures:open_fingers", "open fingers", 4);
-    addConfigValue(CFloatValue, "gestures:open_distance", "open distance", 300.0);
-    addConfigValue(CIntValue, "gestures:open_positive", "open positive", 1);
-
-    // grid specific
-    addConfigValue(CIntValue, "grid:rows", "rows", 3);
-    addConfigValue(CIntValue, "grid:cols", "cols", 3);
-    addConfigValue(CIntValue, "grid:layers", "layers", 1);
-    addConfigValue(CIntValue, "grid:loop_layers", "loop layers", 1);
-    addConfigValue(CIntValue, "grid:loop", "loop", 0);
-    addConfigValue(CIntValue, "grid:gaps_use_aspect_ratio", "gaps use aspect ratio", 0);
-
-    //linear specific
-    addConfigValue(CIntValue, "linear:blur", "blur", 1);
-    addConfigValue(CFloatValue, "linear:height", "height", 300.f);
-    addConfigValue(CFloatValue, "linear:scroll_speed", "scroll speed", 1.f);
-    addConfigValue(CIntValue, "linear:top", "top", 0);
+#define HT_REGISTER_OPTION(VALUE_CLASS, TYPE, KEY, FIELD, DESCR, DEFAULT) \
+    addConfigValue(VALUE_CLASS, KEY, DESCR, DEFAULT);
+    HT_CONFIG_OPTIONS(HT_REGISTER_OPTION)
+#undef HT_REGISTER_OPTION
 
+    HTConfig::refresh();
     // HyprlandAPI::reloadConfig();
 }
 
@@ -9,7 +9,10 @@
 #include <hyprland/src/desktop/DesktopTypes.hpp>
 #include <hyprland/src/desktop/state/ViewState.hpp>
 #include <hyprland/src/managers/KeybindManager.hpp>
+#include <hyprland/src/layout/LayoutManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
+#include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/render/pass/TexPassElement.hpp>
 #include <hyprland/src/state/MonitorState.hpp>
 #include <hyprland/src/state/WorkspacePlacementController.hpp>
 #include <hyprland/src/state/WorkspaceState.hpp>
@@ -17,23 +20,24 @@
 #include "config/shared/workspace/WorkspaceRuleManager.hpp"
 #include "layout/grid.hpp"
 #include "overview.hpp"
+#include "render.hpp"
 
 HTManager::HTManager() {
     swipe_state = HT_SWIPE_NONE;
     swipe_amt = 0.0;
 }
 
+void HTManager::add_view(PHTVIEW view) {
+    if (view == nullptr)
+        return;
+    views.push_back(view);
+    views_by_monitor[view->monitor_id] = view;
+}
+
 PHTVIEW HTManager::get_view_from_monitor(PHLMONITOR monitor) {
     if (monitor == nullptr)
         return nullptr;
-    for (PHTVIEW view : views) {
-        if (view == nullptr)
-            continue;
-        if (view->get_monitor() != monitor)
-            continue;
-        return view;
-    }
-    return nullptr;
+    return get_view_from_id(monitor->m_id);
 }
 
 PHTVIEW HTManager::get_view_from_cursor() {
@@ -42,14 +46,8 @@ PHTVIEW HTManager::get_view_from_cursor() {
 }
 
 PHTVIEW HTManager::get_view_from_id(VIEWID view_id) {
-    for (PHTVIEW view : views) {
-        if (view == nullptr)
-            continue;
-        if (view->monitor_id != view_id)
-            continue;
-        return view;
-    }
-    return nullptr;
+    const auto it = views_by_monitor.find(view_id);
+    return it == views_by_monitor.end() ? nullptr : it->second;
 }
 
 PHLWINDOW HTManager::get_window_from_cursor(bool return_focused) {
@@ -74,26 +72,67 @@ PHLWINDOW HTManager::get_window_from_cursor(bool return_focused) {
         );
     }
 
-    const WORKSPACEID ws_id = cursor_view->layout->get_ws_id_from_global(mouse_coords);
-    const PHLWORKSPACE hovered_workspace = State::workspaceState()->query().id(ws_id).run();
-    if (hovered_workspace == nullptr)
-        return nullptr;
+    // Hit-test what the tiles show, instead of switching the monitor to the hovered workspace
+    // for Hyprland's windowAt. Refreshed first, as the tiles may not have been drawn since the
+    // windows last changed.
+    cursor_view->layout->build_overview_layout(HT_VIEW_ANIMATING);
+    cursor_view->layout->update_visible_windows();
+    return cursor_view->layout->window_at(mouse_coords);
+}
 
-    const Vector2D ws_coords = cursor_view->layout->global_to_local_ws_unscaled(mouse_coords, ws_id)
-        + cursor_monitor->m_position;
+CBox HTManager::get_drag_window_box(PHLWINDOW window, bool with_decorations) {
+    if (window == nullptr)
+        return {};
+    const PHTVIEW cursor_view = get_view_from_cursor();
+    if (cursor_view == nullptr)
+        return {};
 
-    const PHLWORKSPACEREF o_workspace = cursor_monitor->m_activeWorkspace;
-    cursor_monitor->changeWorkspace(hovered_workspace, true);
+    const Vector2D mouse_coords = g_pInputManager->getMouseCoordsInternal();
+    CBox window_box = with_decorations ? window->getFullWindowBoundingBox()
+                                       : window->getWindowMainSurfaceBox();
+    return window_box.translate(-mouse_coords)
+        .scale(cursor_view->layout->drag_window_scale())
+        .translate(mouse_coords);
+}
 
-    const PHLWINDOW hovered_window = Desktop::viewState()->hitTest().windowAt(
-        ws_coords,
-        Desktop::View::RESERVED_EXTENTS | Desktop::View::INPUT_EXTENTS | Desktop::View::ALLOW_FLOATING
-    );
+void HTManager::damage_drag() {
+    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
+    const PHLWINDOW window = target == nullptr ? nullptr : target->window();
 
-    if (o_workspace != nullptr)
-        cursor_monitor->changeWorkspace(o_workspace.lock(), true);
+    CBox window_box = get_drag_window_box(window, true);
+    if (!window_box.empty())
+        window_box.expand(1);
 
-    return hovered_window;
+    if (!last_drag_box.empty())
+        g_pHyprRenderer->damageBox(last_drag_box);
+    if (!window_box.empty())
+        g_pHyprRenderer->damageBox(window_box);
+    last_drag_box = window_box;
+}
+
+void HTManager::render_drag_window(PHLMONITOR monitor, const Time::steady_tp& time) {
+    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
+    const PHLWINDOW window = target == nullptr ? nullptr : target->window();
+    if (window == nullptr || monitor == nullptr)
+        return;
+
+    // The snapshot includes the decorations, so it covers the full bounding box
+    const SP<Render::ITexture> snapshot = drag_snapshot.texture(window);
+    CBox window_box = get_drag_window_box(window, snapshot != nullptr);
+    if (window_box.empty() || window_box.intersection(monitor->logicalBox()).empty())
+        return;
+
+    if (snapshot == nullptr) {
+        render_window_at_box(window, monitor, time, window_box);
+        return;
+    }
+
+    const CBox target_box = window_box.translate(-monitor->m_position).scale(monitor->m_scale);
+    CTexPassElement::SRenderData data;
+    data.tex = snapshot;
+    data.box = drag_snapshot.texture_box(target_box);
+    data.clipBox = target_box;
+    g_pHyprRenderer->m_renderPass.add(makeUnique<CTexPassElement>(std::move(data)));
 }
 
 void HTManager::show_all_views() {
@@ -121,11 +160,19 @@ void HTManager::show_cursor_view() {
 void HTManager::reset() {
     swipe_state = HT_SWIPE_NONE;
     swipe_amt = 0.0;
+    last_drag_box = {};
+    drag_snapshot.clear();
+    frame_states.clear();
     jump_pressed_keys.clear();
+    reset_workspace_index();
+    views_by_monitor.clear();
     views.clear();
 }
 
 void HTManager::refresh_all_grid_caches() {
+    // Monitors came or went, or the rules changed: resync the workspace index from scratch
+    reset_workspace_index();
+
     // Enforce monitor-binding rules globally first. Per-grid refresh below
     // sees one workspace at a time on one monitor; if a rule-bound ws still
     // lives on the wrong monitor, the first grid to refresh would claim it
@@ -183,12 +230,192 @@ void HTManager::refresh_all_grid_caches() {
     }
 }
 
+static HTLayoutGrid* view_grid(const PHTVIEW& view) {
+    if (view == nullptr || view->layout == nullptr || view->layout->layout_name() != "grid")
+        return nullptr;
+    return static_cast<HTLayoutGrid*>(view->layout.get());
+}
+
+void HTManager::on_workspace_created(PHLWORKSPACE workspace) {
+    if (workspace == nullptr || workspace->m_isSpecialWorkspace)
+        return;
+    index_add_workspace(workspace->monitorID(), workspace->m_id);
+
+    HTLayoutGrid* grid = view_grid(get_view_from_monitor(workspace->m_monitor.lock()));
+    if (grid == nullptr)
+        return;
+
+    // Another grid showing the id as a placeholder has to hand it over, which takes a full
+    // refresh. Rare, the id would have to be created from outside the overview.
+    for (const PHTVIEW& view : views) {
+        const HTLayoutGrid* other = view_grid(view);
+        if (other != nullptr && other != grid && other->cache().contains(workspace->m_id)) {
+            refresh_all_grid_caches();
+            return;
+        }
+    }
+    grid->add_workspace(workspace->m_id);
+}
+
+void HTManager::on_workspace_removed(PHLWORKSPACE workspace) {
+    if (workspace == nullptr)
+        return;
+    index_remove_workspace(workspace->m_id);
+
+    for (const PHTVIEW& view : views) {
+        HTLayoutGrid* grid = view_grid(view);
+        if (grid == nullptr || !grid->cache().contains(workspace->m_id))
+            continue;
+        if (!grid->remove_workspace(workspace->m_id, false))
+            refresh_all_grid_caches();
+        return;
+    }
+}
+
+void HTManager::on_workspace_moved(PHLWORKSPACE workspace, PHLMONITOR monitor) {
+    if (workspace == nullptr || monitor == nullptr || workspace->m_isSpecialWorkspace)
+        return;
+    index_remove_workspace(workspace->m_id);
+    index_add_workspace(monitor->m_id, workspace->m_id);
+
+    const PHTVIEW target_view = get_view_from_monitor(monitor);
+    for (const PHTVIEW& view : views) {
+        HTLayoutGrid* grid = view_grid(view);
+        if (grid == nullptr || view == target_view || !grid->cache().contains(workspace->m_id))
+            continue;
+        if (!grid->remove_workspace(workspace->m_id, true)) {
+            refresh_all_grid_caches();
+            return;
+        }
+    }
+    if (HTLayoutGrid* grid = view_grid(target_view); grid != nullptr)
+        grid->add_workspace(workspace->m_id);
+}
+
+bool HTManager::workspace_id_claimed(WORKSPACEID id) {
+    if (State::workspaceState()->query().id(id).run() != nullptr)
+        return true;
+    for (const auto& rule : Config::workspaceRuleMgr()->getAllWorkspaceRules()) {
+        if (rule->m_workspaceId == id)
+            return true;
+    }
+    for (const PHTVIEW& view : views) {
+        const HTLayoutGrid* grid = view_grid(view);
+        if (grid != nullptr && grid->cache().contains(id))
+            return true;
+    }
+    return false;
+}
+
+const std::vector<WORKSPACEID>& HTManager::monitor_workspaces(MONITORID monitor_id) {
+    const auto [it, inserted] = workspace_index.try_emplace(monitor_id);
+    if (inserted) {
+        for (const auto& workspace : State::workspaceState()->workspaces()) {
+            if (workspace == nullptr || workspace->m_isSpecialWorkspace)
+                continue;
+            if (workspace->monitorID() == monitor_id)
+                it->second.push_back(workspace->m_id);
+        }
+        std::sort(it->second.begin(), it->second.end());
+    }
+    return it->second;
+}
+
+void HTManager::index_add_workspace(MONITORID monitor_id, WORKSPACEID id) {
+    workspaces_generation++;
+    // Not indexed yet: the first monitor_workspaces call will find it
+    const auto it = workspace_index.find(monitor_id);
+    if (it == workspace_index.end())
+        return;
+    std::vector<WORKSPACEID>& ids = it->second;
+    const auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+    if (pos == ids.end() || *pos != id)
+        ids.insert(pos, id);
+}
+
+void HTManager::index_remove_workspace(WORKSPACEID id) {
+    workspaces_generation++;
+    for (auto& [monitor_id, ids] : workspace_index) {
+        const auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+        if (pos != ids.end() && *pos == id)
+            ids.erase(pos);
+    }
+}
+
+void HTManager::reset_workspace_index() {
+    workspace_index.clear();
+    workspaces_generation++;
+}
+
 void HTManager::remove_view_for_monitor_id(MONITORID mid) {
+    views_by_monitor.erase(mid);
+    frame_states.erase(mid);
     std::erase_if(views, [mid](const PHTVIEW& v) {
         return v == nullptr || v->monitor_id == mid;
     });
 }
 
+void HTManager::on_window_damage(PHLWINDOW window) {
+    if (window == nullptr)
+        return;
+
+    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
+    if (target != nullptr && target->window() == window)
+        damage_drag();
+
+    const PHTVIEW view = get_view_from_monitor(window->m_monitor.lock());
+    if (view == nullptr || view->layout == nullptr)
+        return;
+    view->layout->damage_window(window);
+}
+
+void HTManager::on_window_commit(PHLWINDOW window) {
+    drag_snapshot.damage(window);
+    on_window_damage(window);
+}
+
+void HTManager::on_monitor_damage(PHLMONITOR monitor) {
+    const PHTVIEW view = get_view_from_monitor(monitor);
+    if (view == nullptr || view->layout == nullptr)
+        return;
+    view->layout->damage_all_workspaces();
+}
+
+void HTManager::on_render_pre(PHLMONITOR monitor) {
+    if (monitor != nullptr)
+        frame_states[monitor->m_id] = {.overview_renders = compute_overview_renders(monitor)};
+
+    // Drags can also end without going through end_window_drag
+    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
+    if (target == nullptr || target->window() == nullptr)
+        drag_snapshot.clear();
+    else
+        drag_snapshot.refresh();
+
+    const PHTVIEW view = get_view_from_monitor(monitor);
+    if (view == nullptr || view->layout == nullptr)
+        return;
+    view->layout->pre_render();
+}
+
+bool HTManager::overview_renders(PHLMONITOR monitor) {
+    if (monitor != nullptr)
+        if (const auto it = frame_states.find(monitor->m_id); it != frame_states.end())
+            return it->second.overview_renders;
+    return compute_overview_renders(monitor);
+}
+
+bool HTManager::compute_overview_renders(PHLMONITOR monitor) {
+    const PHTVIEW view = get_view_from_monitor(monitor);
+    if (view == nullptr)
+        return false;
+    if (view->active || view->navigating)
+        return true;
+    // A window dragged out of an open overview is drawn scaled at the cursor on every monitor
+    const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
+    return target != nullptr && target->window() != nullptr && has_active_view();
+}
+
 bool HTManager::has_active_view() {
     for (const auto& view : views) {
         if (view == nullptr)
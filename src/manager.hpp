@@ -3,15 +3,21 @@
 #include <hyprland/src/desktop/DesktopTypes.hpp>
 #include <hyprland/src/devices/IKeyboard.hpp>
 #include <hyprland/src/helpers/AnimatedVariable.hpp>
+#include <hyprland/src/helpers/time/Time.hpp>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "overview.hpp"
+#include "thumbnail.hpp"
 
 class HTManager {
   public:
     HTManager();
 
+    // Add views with add_view, so they are indexed by monitor
     std::vector<PHTVIEW> views;
+    void add_view(PHTVIEW view);
 
     PHTVIEW get_view_from_monitor(PHLMONITOR pMonitor);
     PHTVIEW get_view_from_cursor();
@@ -19,6 +25,13 @@ class HTManager {
 
     PHLWINDOW get_window_from_cursor(bool return_focused = true);
 
+    // Where the dragged window is drawn, scaled about the cursor (global, logical)
+    CBox get_drag_window_box(PHLWINDOW window, bool with_decorations = false);
+    // Damage the dragged window's previous and current on-screen rect
+    void damage_drag();
+    // Draw the dragged window at the cursor, from its snapshot when there is one
+    void render_drag_window(PHLMONITOR monitor, const Time::steady_tp& time);
+
     void reset();
 
     void show_all_views();
@@ -26,6 +39,18 @@ class HTManager {
     void show_cursor_view();
 
     void refresh_all_grid_caches();
+    // Keep the grid slots in step with single workspace changes, without a full refresh
+    void on_workspace_created(PHLWORKSPACE workspace);
+    void on_workspace_removed(PHLWORKSPACE workspace);
+    void on_workspace_moved(PHLWORKSPACE workspace, PHLMONITOR monitor);
+    // Whether a workspace, workspace rule or grid slot already uses `id`
+    bool workspace_id_claimed(WORKSPACEID id);
+
+    // Ids of the non-special workspaces on a monitor, sorted. Built on first use, then kept
+    // up to date by the workspace events.
+    const std::vector<WORKSPACEID>& monitor_workspaces(MONITORID monitor_id);
+    // Bumped on every change to any monitor's workspaces
+    uint64_t workspaces_generation = 1;
     void remove_view_for_monitor_id(MONITORID mid);
 
     bool start_window_drag();
@@ -41,6 +66,10 @@ class HTManager {
         HT_SWIPE_NONE,
     };
 
+    CBox last_drag_box;
+    // The dragged window as captured when the drag started, recaptured when it commits
+    HTWindowSnapshot drag_snapshot;
+
     swipe_state_t swipe_state;
     float swipe_amt;
     std::unordered_set<uint32_t> jump_pressed_keys;
@@ -48,6 +77,37 @@ class HTManager {
     bool swipe_update(IPointer::SSwipeUpdateEvent e);
     bool swipe_end();
 
+    // Route compositor damage to the view of the affected monitor
+    void on_window_damage(PHLWINDOW window);
+    // A window's surface committed new content
+    void on_window_commit(PHLWINDOW window);
+    void on_monitor_damage(PHLMONITOR monitor);
+    void on_render_pre(PHLMONITOR monitor);
+
+    // Whether hyprtasking drives `monitor`'s rendering: its own view open or animating, or a
+    // window being dragged out of an overview open elsewhere. Other monitors keep Hyprland's
+    // native path. Answered from the monitor's snapshot taken in on_render_pre, so per-surface
+    // render hooks don't scan the views.
+    bool overview_renders(PHLMONITOR monitor);
+
     bool has_active_view();
     bool cursor_view_active();
+
+  private:
+    // Taken in on_render_pre, so valid for the rest of that monitor's frame
+    struct HTFrameState {
+        bool overview_renders = false;
+    };
+    std::unordered_map<MONITORID, HTFrameState> frame_states;
+
+    // Same views as `views`, by monitor id (equal to the view id)
+    std::unordered_map<MONITORID, PHTVIEW> views_by_monitor;
+
+    bool compute_overview_renders(PHLMONITOR monitor);
+
+    std::unordered_map<MONITORID, std::vector<WORKSPACEID>> workspace_index;
+    void index_add_workspace(MONITORID monitor_id, WORKSPACEID id);
+    void index_remove_workspace(WORKSPACEID id);
+    // Drop every monitor's index, rebuilt lazily. For changes too broad to follow one by one.
+    void reset_workspace_index();
 };
@@ -25,7 +25,7 @@ HTView::HTView(MONITORID in_monitor_id) {
     closing = false;
     navigating = false;
 
-    std::string val = HTConfig::value<Config::STRING>("layout");
+    std::string val = HTConfig::options().layout;
     change_layout(val);
 }
 
@@ -62,7 +62,7 @@ void HTView::do_exit_behavior(bool exit_on_mouse) {
         return layout->get_ws_id_from_global(mouse_coords);
     };
 
-    const int EXIT_ON_HOVERED = HTConfig::value<Config::INTEGER>("exit_on_hovered");
+    const int EXIT_ON_HOVERED = HTConfig::options().exit_on_hovered;
 
     const WORKSPACEID ws_id =
         (exit_on_mouse || EXIT_ON_HOVERED) ? try_get_hover_id() : monitor->m_activeWorkspace->m_id;
@@ -176,7 +176,7 @@ void HTView::move_id(WORKSPACEID ws_id, bool move_window) {
 
     if (move_window) {
         Desktop::focusState()->fullWindowFocus(hovered_window, Desktop::FOCUS_REASON_CLICK);
-        warp = *CConfigValue<Config::INTEGER>("plugin:hyprtasking:warp_on_move_window");
+        warp = HTConfig::options().warp_on_move_window;
     } else {
         warp = *CConfigValue<Config::INTEGER>("cursor:warp_on_change_workspace");
     }
@@ -207,15 +207,25 @@ void HTView::move(std::string arg, bool move_window) {
     } else {
         layout->build_overview_layout(HT_VIEW_CLOSED);
     }
-    const auto ws_layout = layout->overview_layout[source_ws_id];
-    const WORKSPACEID id = layout->get_ws_id_in_direction(ws_layout.x, ws_layout.y, arg);
+    const auto [source_x, source_y] = layout->get_ws_xy(source_ws_id);
+    const WORKSPACEID id = layout->get_ws_id_in_direction(source_x, source_y, arg);
 
     move_id(id, move_window);
 }
 
 PHLMONITOR HTView::get_monitor() {
-    const PHLMONITOR monitor = State::monitorState()->query().id(monitor_id).run();
-    if (monitor == nullptr)
-        Log::logger->log(Log::WARN, "[Hyprtasking] Returning null monitor from get_monitor!");
-    return monitor;
+    if (const PHLMONITOR cached = monitor_ref.lock(); cached != nullptr)
+        return cached;
+
+    const PHLMONITOR resolved = State::monitorState()->query().id(monitor_id).run();
+    if (resolved == nullptr) {
+        // Only when the monitor just went away, not on every call until it is back
+        if (monitor_resolved)
+            Log::logger->log(Log::WARN, "[Hyprtasking] Returning null monitor from get_monitor!");
+        monitor_resolved = false;
+        return nullptr;
+    }
+    monitor_ref = resolved;
+    monitor_resolved = true;
+    return resolved;
 }
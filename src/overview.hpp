@@ -24,6 +24,10 @@ class HTView {
     void change_layout(const std::string& layout_name);
 
     MONITORID monitor_id;
+    // Resolved from monitor_id on first use, and again only once it expires
+    PHLMONITORREF monitor_ref;
+    // Whether monitor_ref held a live monitor when last resolved; the loss is logged once
+    bool monitor_resolved = false;
 
     SP<HTLayoutBase> layout;
 
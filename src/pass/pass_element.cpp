@@ -1,5 +1,7 @@
 #include "pass_element.hpp"
 
+#include <hyprland/src/render/OpenGL.hpp>
+
 HTPassElement::HTPassElement() {
     ;
 }
@@ -20,3 +22,38 @@ bool HTPassElement::needsPrecomputeBlur() {
 bool HTPassElement::disableSimplification() {
     return true;
 }
+
+bool HTBatchPassElement::empty() const {
+    return rects.empty() && borders.empty() && textures.empty();
+}
+
+std::vector<UP<IPassElement>> HTBatchPassElement::draw() {
+    for (const HTRect& rect : rects) {
+        Render::GL::CHyprOpenGLImpl::SRectRenderData data;
+        data.round = rect.round;
+        g_pHyprOpenGL->renderRect(rect.box, rect.color, data);
+    }
+    for (const HTBorder& border : borders) {
+        Render::GL::CHyprOpenGLImpl::SBorderRenderData data;
+        data.round = border.round;
+        data.borderSize = border.border_size;
+        g_pHyprOpenGL->renderBorder(border.box, border.grad, data);
+    }
+    for (const HTTexture& texture : textures) {
+        if (texture.tex == nullptr)
+            continue;
+        Render::GL::CHyprOpenGLImpl::STextureRenderData data;
+        if (!texture.clip.empty())
+            data.clipRegion = texture.clip;
+        g_pHyprOpenGL->renderTexture(texture.tex, texture.box, data);
+    }
+    return {};
+}
+
+bool HTBatchPassElement::needsPrecomputeBlur() {
+    return false;
+}
+
+bool HTBatchPassElement::disableSimplification() {
+    return false;
+}
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <hyprland/src/config/ConfigManager.hpp>
+#include <hyprland/src/helpers/Color.hpp>
+#include <hyprland/src/render/Texture.hpp>
 #include <hyprland/src/render/pass/PassElement.hpp>
+#include <hyprutils/math/Box.hpp>
+#include <vector>
 
 class HTPassElement: public IPassElement {
   public:
@@ -19,3 +24,40 @@ class HTPassElement: public IPassElement {
         return "HTDisableSimplification";
     }
 };
+
+// Draws any number of rects, borders and textures from one pass element, in that order, instead
+// of allocating and submitting a Hyprland pass element for each. Boxes are monitor-local pixels.
+class HTBatchPassElement: public HTPassElement {
+  public:
+    struct HTRect {
+        CBox box;
+        CHyprColor color;
+        int round = 0;
+    };
+    struct HTBorder {
+        CBox box;
+        Config::CGradientValueData grad;
+        float border_size;
+        int round = 0;
+    };
+    struct HTTexture {
+        SP<Render::ITexture> tex;
+        CBox box;
+        // Only this part of `box` is drawn, if set
+        CBox clip;
+    };
+
+    std::vector<HTRect> rects;
+    std::vector<HTBorder> borders;
+    std::vector<HTTexture> textures;
+
+    bool empty() const;
+
+    virtual std::vector<UP<IPassElement>> draw() override;
+    virtual bool needsPrecomputeBlur() override;
+    virtual bool disableSimplification() override;
+
+    virtual const char* passName() override {
+        return "HTBatchPassElement";
+    }
+};
@@ -1,19 +1,26 @@
-#include "render.hpp"
-
+#include <algorithm>
+#include <initializer_list>
 #include <utility>
 
+#define private public
+#include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/render/pass/ClearPassElement.hpp>
+#undef private
+
 #include <hyprland/src/Compositor.hpp>
 #include <hyprland/src/config/ConfigValue.hpp>
 #include <hyprland/src/desktop/DesktopTypes.hpp>
 #include <hyprland/src/animation/WorkspaceAnimationController.hpp>
+#include <hyprland/src/layout/LayoutManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
 #include <hyprland/src/render/OpenGL.hpp>
-#include <hyprland/src/render/Renderer.hpp>
 #include <hyprland/src/render/pass/RendererHintsPassElement.hpp>
 #include <hyprutils/math/Vector2D.hpp>
 
 #include "globals.hpp"
+#include "render.hpp"
 #include "src/helpers/time/Time.hpp"
+#include "src/layout/target/Target.hpp"
 #include "types.hpp"
 
 using namespace Render;
@@ -37,7 +44,8 @@ void render_window_at_box(PHLWINDOW window, PHLMONITOR monitor, const Time::stea
         makeUnique<CRendererHintsPassElement>(CRendererHintsPassElement::SData {data})
     );
 
-    g_pHyprRenderer->damageWindow(window);
+    // No damageWindow here: it would re-enter the damage hooks, scheduling another frame and
+    // dirtying the window's tile every frame. The caller damages the rect it draws into.
     ((render_window_t)render_window)(
         g_pHyprRenderer.get(),
         window,
@@ -54,6 +62,170 @@ void render_window_at_box(PHLWINDOW window, PHLMONITOR monitor, const Time::stea
     ));
 }
 
+void render_workspace_original(
+    PHLMONITOR monitor,
+    PHLWORKSPACE workspace,
+    const Time::steady_tp& time,
+    const CBox& box
+) {
+    auto& elements = g_pHyprRenderer->m_renderPass.m_passElements;
+    const size_t first = elements.size();
+
+    ((render_workspace_t)(render_workspace_hook->m_original))(
+        g_pHyprRenderer.get(), monitor, workspace, time, box
+    );
+
+    // Hyprland clears the frame before drawing a workspace, which would wipe every tile drawn
+    // so far. Only this call's elements are checked.
+    const auto is_clear = [](const auto& e) {
+        return dynamic_cast<CClearPassElement*>(e.element.get()) != nullptr;
+    };
+    elements.erase(
+        std::remove_if(elements.begin() + first, elements.end(), is_clear),
+        elements.end()
+    );
+}
+
+std::vector<PHLWINDOW> workspace_windows_in_order(PHLWORKSPACE workspace) {
+    std::vector<PHLWINDOW> windows;
+    if (workspace == nullptr)
+        return windows;
+
+    const auto on_workspace = [&](const PHLWINDOW& w) {
+        return w->m_workspace == workspace && (w->m_isMapped || w->m_fadingOut) && !w->isHidden();
+    };
+
+    // m_windows keeps floating windows in their z-order, so one pass per class is enough.
+    if (workspace->m_hasFullscreenWindow) {
+        const PHLWINDOW fullscreen = workspace->getFullscreenWindow();
+        if (fullscreen != nullptr)
+            windows.push_back(fullscreen);
+        for (const auto& w : g_pCompositor->m_windows) {
+            if (on_workspace(w) && w != fullscreen && w->m_isFloating && w->m_createdOverFullscreen)
+                windows.push_back(w);
+        }
+        return windows;
+    }
+
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (on_workspace(w) && !w->m_isFloating)
+            windows.push_back(w);
+    }
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (on_workspace(w) && w->m_isFloating)
+            windows.push_back(w);
+    }
+    return windows;
+}
+
+bool can_render_workspace_direct(PHLMONITOR monitor, PHLWORKSPACE workspace) {
+    if (monitor == nullptr || workspace == nullptr)
+        return true;
+    // renderWindow multiplies every window's alpha by its workspace's; hidden workspaces keep
+    // the value their last OUT animation left, which is 0 with the fade styles.
+    return !workspace->m_isSpecialWorkspace && workspace->m_alpha->value() >= 1.f;
+}
+
+static void set_render_modif(Vector2D translate, float scale) {
+    SRenderModifData data {};
+    data.modifs.push_back({SRenderModifData::eRenderModifType::RMOD_TYPE_TRANSLATE, translate});
+    data.modifs.push_back({SRenderModifData::eRenderModifType::RMOD_TYPE_SCALE, scale});
+    g_pHyprRenderer->m_renderPass.add(
+        makeUnique<CRendererHintsPassElement>(CRendererHintsPassElement::SData {data})
+    );
+}
+
+static void render_layers(
+    PHLMONITOR monitor,
+    const Time::steady_tp& time,
+    std::initializer_list<zwlr_layer_shell_v1_layer> layers,
+    bool popups
+) {
+    for (const zwlr_layer_shell_v1_layer layer : layers) {
+        for (const auto& ls : monitor->m_layerSurfaceLayers[layer])
+            g_pHyprRenderer->renderLayer(ls.lock(), monitor, time, popups);
+    }
+}
+
+// Everything Hyprland draws for a workspace, in its order: wallpaper, background and bottom
+// layers, windows, popups, then top and overlay layers and the layers' popups. Layers go under
+// the same renderModif renderWorkspace would use for `render_box`; windows additionally undo
+// the workspace's render offset (left over from its last slide out), so nothing is swapped or
+// animated.
+static void render_workspace_direct(
+    PHLMONITOR monitor,
+    PHLWORKSPACE workspace,
+    const Time::steady_tp& time,
+    const CBox& render_box,
+    float ws_scale
+) {
+    set_render_modif(render_box.pos(), ws_scale);
+    g_pHyprRenderer->renderBackground(monitor);
+    render_layers(
+        monitor,
+        time,
+        {ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND, ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM},
+        false
+    );
+
+    const std::vector<PHLWINDOW> windows = workspace_windows_in_order(workspace);
+    if (!windows.empty()) {
+        const SP<Layout::ITarget> target = g_layoutManager->dragController()->target();
+        const PHLWINDOW dragged_window = target == nullptr ? nullptr : target->window();
+        const PHTVIEW view =
+            ht_manager == nullptr ? nullptr : ht_manager->get_view_from_monitor(monitor);
+
+        set_render_modif(
+            render_box.pos() - workspace->m_renderOffset->value() * monitor->m_scale,
+            ws_scale
+        );
+
+        // Same two passes as Hyprland: every window, then every window's popups on top.
+        for (const eRenderPassMode mode : {RENDER_PASS_MAIN, RENDER_PASS_POPUP}) {
+            for (const PHLWINDOW& window : windows) {
+                if (window == dragged_window)
+                    continue;
+                // Popups reach outside the window, so only the main pass is culled
+                if (mode == RENDER_PASS_MAIN && view != nullptr && view->layout != nullptr
+                    && view->layout->is_occluded(window))
+                    continue;
+                ((render_window_t)render_window)(
+                    g_pHyprRenderer.get(),
+                    window,
+                    monitor,
+                    time,
+                    true,
+                    mode,
+                    false,
+                    false
+                );
+            }
+        }
+
+        set_render_modif(render_box.pos(), ws_scale);
+    }
+
+    render_layers(
+        monitor,
+        time,
+        {ZWLR_LAYER_SHELL_V1_LAYER_TOP, ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY},
+        false
+    );
+    render_layers(
+        monitor,
+        time,
+        {ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND,
+         ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM,
+         ZWLR_LAYER_SHELL_V1_LAYER_TOP,
+         ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY},
+        true
+    );
+
+    g_pHyprRenderer->m_renderPass.add(makeUnique<CRendererHintsPassElement>(
+        CRendererHintsPassElement::SData {SRenderModifData {}}
+    ));
+}
+
 void render_workspace_at_box(
     PHLMONITOR monitor,
     PHLWORKSPACE workspace,
@@ -71,9 +243,18 @@ void render_workspace_at_box(
     if (monitor->m_transform % 2 == 1)
         std::swap(render_box.w, render_box.h);
 
+    const bool swap_in = workspace != nullptr
+        && (workspace != monitor->m_activeWorkspace || !workspace->m_visible);
+    if (swap_in && can_render_workspace_direct(monitor, workspace)) {
+        render_workspace_direct(monitor, workspace, time, render_box, ws_scale);
+        return;
+    }
+
     // Hyprland only fully renders the monitor's active workspace, so make this one
     // active+visible while we render it. The caller restores the original active ws.
-    if (workspace != nullptr) {
+    // A workspace that already is active+visible is rendered as is: restarting its
+    // animations would damage the whole monitor on every frame.
+    if (swap_in) {
         monitor->m_activeWorkspace = workspace;
         Animation::Workspace::startAnimation(
             workspace, Animation::Workspace::ANIMATION_TYPE_IN, false, true
@@ -81,11 +262,9 @@ void render_workspace_at_box(
         workspace->m_visible = true;
     }
 
-    ((render_workspace_t)(render_workspace_hook->m_original))(
-        g_pHyprRenderer.get(), monitor, workspace, time, render_box
-    );
+    render_workspace_original(monitor, workspace, time, render_box);
 
-    if (workspace != nullptr) {
+    if (swap_in) {
         Animation::Workspace::startAnimation(
             workspace, Animation::Workspace::ANIMATION_TYPE_OUT, false, true
         );
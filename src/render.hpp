@@ -4,11 +4,32 @@
 #include <hyprland/src/plugins/PluginAPI.hpp>
 #include <hyprland/src/helpers/time/Time.hpp>
 #include <hyprutils/math/Box.hpp>
+#include <vector>
 
 void render_window_at_box(PHLWINDOW window, PHLMONITOR monitor, const Time::steady_tp& time, CBox box);
 
+// Hyprland's own renderWorkspace (`box` as it expects it), minus the clear it adds up front.
+void render_workspace_original(
+    PHLMONITOR monitor,
+    PHLWORKSPACE workspace,
+    const Time::steady_tp& time,
+    const CBox& box
+);
+
+// Mapped windows of a workspace in the order Hyprland stacks them: tiled, then floating. With
+// a fullscreen window, only it and the floating windows created over it.
+std::vector<PHLWINDOW> workspace_windows_in_order(PHLWORKSPACE workspace);
+
+// Whether render_workspace_at_box can draw `workspace` without touching the monitor's active
+// workspace. False for workspaces a fade animation left transparent, and for special ones.
+bool can_render_workspace_direct(PHLMONITOR monitor, PHLWORKSPACE workspace);
+
 // Render a workspace's contents scaled into `box` (monitor-local, relative to (0,0)).
-// Handles the active-workspace swap Hyprland requires to fully render a non-active
-// workspace; the caller must restore monitor->m_activeWorkspace afterwards. `workspace`
-// may be null, in which case only the layers/wallpaper are drawn.
+// The monitor's active (and visible) workspace is rendered as is. Any other workspace is
+// drawn directly (layers and windows, stacked as Hyprland does) when
+// can_render_workspace_direct allows it.
+// Otherwise it falls back to the active-workspace swap Hyprland requires to fully render a
+// non-active workspace; the caller must then hide the real active workspace beforehand and
+// restore monitor->m_activeWorkspace afterwards. `workspace` may be null, in which case
+// only the layers/wallpaper are drawn.
 void render_workspace_at_box(PHLMONITOR monitor, PHLWORKSPACE workspace, const Time::steady_tp& time, CBox box);
@@ -0,0 +1,194 @@
+#include "thumbnail.hpp"
+
+#include <hyprland/src/output/Monitor.hpp>
+#include <hyprland/src/render/OpenGL.hpp>
+#include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/render/pass/RendererHintsPassElement.hpp>
+
+#include "globals.hpp"
+#include "render.hpp"
+
+void HTThumbnailCache::damage(WORKSPACEID ws_id) {
+    const auto it = thumbnails.find(ws_id);
+    if (it != thumbnails.end())
+        it->second.dirty = true;
+}
+
+void HTThumbnailCache::damage_all() {
+    for (auto& [id, thumbnail] : thumbnails)
+        thumbnail.dirty = true;
+}
+
+void HTThumbnailCache::clear() {
+    thumbnails.clear();
+}
+
+bool HTThumbnailCache::needs_refresh(WORKSPACEID ws_id) const {
+    const auto it = thumbnails.find(ws_id);
+    return it == thumbnails.end() || it->second.dirty;
+}
+
+bool HTThumbnailCache::has(WORKSPACEID ws_id) const {
+    return thumbnails.contains(ws_id);
+}
+
+Time::steady_tp HTThumbnailCache::last_refresh(WORKSPACEID ws_id) const {
+    const auto it = thumbnails.find(ws_id);
+    if (it == thumbnails.end())
+        return {};
+    return it->second.last_refresh;
+}
+
+void HTThumbnailCache::refresh(
+    PHLMONITOR monitor,
+    PHLWORKSPACE workspace,
+    WORKSPACEID ws_id,
+    Vector2D size
+) {
+    if (monitor == nullptr)
+        return;
+
+    size = size.round();
+    if (size.x < 1 || size.y < 1)
+        return;
+
+    // beginRender sets up the viewport and projection for the monitor, so the target has to
+    // be the monitor's size for a transformed (rotated, flipped) output to land right.
+    HTThumbnail& thumbnail = thumbnails[ws_id];
+    if (thumbnail.fb.m_size != monitor->m_pixelSize) {
+        thumbnail.fb.release();
+        thumbnail.fb.alloc(monitor->m_pixelSize.x, monitor->m_pixelSize.y);
+    }
+    thumbnail.size = size;
+    thumbnail.monitor_size = monitor->m_transformedSize;
+
+    CRegion fake_damage {0, 0, INT16_MAX, INT16_MAX};
+    g_pHyprRenderer->makeEGLCurrent();
+    g_pHyprRenderer->beginRender(monitor, fake_damage, RENDER_MODE_FULL_FAKE, nullptr, &thumbnail.fb);
+    g_pHyprOpenGL->clear(CHyprColor {0, 0, 0, 1.0});
+
+    // Scaled straight into the requested size, so the cost of drawing follows the size of the
+    // tile rather than the resolution of the monitor.
+    render_workspace_at_box(monitor, workspace, Time::steadyNow(), CBox {{0, 0}, size});
+
+    g_pHyprRenderer->endRender();
+    thumbnail.dirty = false;
+    thumbnail.last_refresh = Time::steadyNow();
+}
+
+SP<Render::ITexture> HTThumbnailCache::texture(WORKSPACEID ws_id) {
+    const auto it = thumbnails.find(ws_id);
+    if (it == thumbnails.end())
+        return nullptr;
+    return it->second.fb.getTexture();
+}
+
+CBox HTThumbnailCache::texture_box(WORKSPACEID ws_id, const CBox& box) const {
+    const auto it = thumbnails.find(ws_id);
+    if (it == thumbnails.end() || it->second.size.x < 1)
+        return box;
+    const double scale = box.w / it->second.size.x;
+    return CBox {box.pos(), it->second.monitor_size * scale};
+}
+
+void HTWindowSnapshot::capture(PHLWINDOW new_window) {
+    const PHLMONITOR monitor = new_window == nullptr ? nullptr : new_window->m_monitor.lock();
+    const PHLWORKSPACE workspace = new_window == nullptr ? nullptr : new_window->m_workspace;
+    // renderWindow multiplies in the workspace's alpha, which the snapshot can't undo
+    if (monitor == nullptr || workspace == nullptr
+        || !can_render_workspace_direct(monitor, workspace)) {
+        clear();
+        return;
+    }
+
+    const CBox window_box = new_window->getFullWindowBoundingBox();
+    const Vector2D window_size = window_box.size() * monitor->m_scale;
+    if (window_size.x < 1 || window_size.y < 1) {
+        clear();
+        return;
+    }
+    // Monitor-sized like the thumbnails, as beginRender applies the monitor's viewport and
+    // transform. The window goes in the top-left `size` of it.
+    if (fb.m_size != monitor->m_pixelSize) {
+        fb.release();
+        fb.alloc(monitor->m_pixelSize.x, monitor->m_pixelSize.y);
+    }
+    size = window_size;
+    monitor_size = monitor->m_transformedSize;
+
+    CRegion fake_damage {0, 0, INT16_MAX, INT16_MAX};
+    g_pHyprRenderer->makeEGLCurrent();
+    g_pHyprRenderer->beginRender(monitor, fake_damage, RENDER_MODE_FULL_FAKE, nullptr, &fb);
+    g_pHyprOpenGL->clear(CHyprColor {0, 0, 0, 0});
+
+    // Move the window's bounding box to the framebuffer's origin. renderWindow also adds the
+    // workspace's render offset, so take that back out.
+    const Vector2D render_offset =
+        new_window->m_pinned ? Vector2D {} : workspace->m_renderOffset->value();
+    const Vector2D transform =
+        (monitor->m_position - window_box.pos() - render_offset) * monitor->m_scale;
+
+    SRenderModifData data {};
+    data.modifs.push_back({SRenderModifData::eRenderModifType::RMOD_TYPE_TRANSLATE, transform});
+    g_pHyprRenderer->m_renderPass.add(
+        makeUnique<CRendererHintsPassElement>(CRendererHintsPassElement::SData {data})
+    );
+    ((render_window_t)render_window)(
+        g_pHyprRenderer.get(),
+        new_window,
+        monitor,
+        Time::steadyNow(),
+        true,
+        RENDER_PASS_MAIN,
+        false,
+        true
+    );
+    g_pHyprRenderer->m_renderPass.add(makeUnique<CRendererHintsPassElement>(
+        CRendererHintsPassElement::SData {SRenderModifData {}}
+    ));
+
+    g_pHyprRenderer->endRender();
+    window = new_window;
+    dirty = false;
+}
+
+void HTWindowSnapshot::request(PHLWINDOW new_window) {
+    if (window.lock() != new_window)
+        clear();
+    window = new_window;
+    dirty = true;
+}
+
+void HTWindowSnapshot::damage(PHLWINDOW damaged_window) {
+    if (damaged_window != nullptr && window.lock() == damaged_window)
+        dirty = true;
+}
+
+void HTWindowSnapshot::refresh() {
+    const PHLWINDOW snapshot_window = window.lock();
+    if (snapshot_window == nullptr) {
+        clear();
+        return;
+    }
+    if (dirty)
+        capture(snapshot_window);
+}
+
+void HTWindowSnapshot::clear() {
+    fb.release();
+    size = {};
+    window = {};
+    dirty = true;
+}
+
+CBox HTWindowSnapshot::texture_box(const CBox& box) const {
+    if (size.x < 1)
+        return box;
+    return CBox {box.pos(), monitor_size * (box.w / size.x)};
+}
+
+SP<Render::ITexture> HTWindowSnapshot::texture(PHLWINDOW of_window) {
+    if (of_window == nullptr || window.lock() != of_window || !fb.isAllocated())
+        return nullptr;
+    return fb.getTexture();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/helpers/time/Time.hpp>
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <hyprland/src/render/Texture.hpp>
+#include <hyprutils/math/Box.hpp>
+#include <hyprutils/math/Vector2D.hpp>
+#include <unordered_map>
+
+#include "types.hpp"
+
+// Offscreen copy of a workspace's contents, used in place of a live render for the tile.
+struct HTThumbnail {
+    // Always at the monitor's pixel size, so the monitor's viewport and transform apply as is.
+    // The workspace is drawn into the top-left `size` of it (transformed pixels).
+    CFramebuffer fb;
+    Vector2D size;
+    Vector2D monitor_size;
+    bool dirty = true;
+    Time::steady_tp last_refresh;
+};
+
+class HTThumbnailCache {
+  public:
+    // Mark a workspace's thumbnail stale; it is redrawn on the next refresh.
+    void damage(WORKSPACEID ws_id);
+    void damage_all();
+    // Release every framebuffer.
+    void clear();
+
+    bool needs_refresh(WORKSPACEID ws_id) const;
+    // Whether the thumbnail has been rendered at least once
+    bool has(WORKSPACEID ws_id) const;
+    Time::steady_tp last_refresh(WORKSPACEID ws_id) const;
+
+    // Render `workspace` into the thumbnail of `ws_id`, at `size` (transformed pixels; the
+    // monitor's size for a full resolution copy). Begins its own render, so this must never
+    // be called from inside a monitor's render pass. Goes through render_workspace_at_box,
+    // so unless can_render_workspace_direct holds, the caller must hide the active workspace
+    // and restore monitor->m_activeWorkspace.
+    void refresh(PHLMONITOR monitor, PHLWORKSPACE workspace, WORKSPACEID ws_id, Vector2D size);
+
+    // Texture of the last refresh (possibly stale), or null if never rendered.
+    SP<Render::ITexture> texture(WORKSPACEID ws_id);
+    // Box to draw the whole texture at so the workspace lands on `box`; clip to `box`.
+    CBox texture_box(WORKSPACEID ws_id, const CBox& box) const;
+
+  private:
+    std::unordered_map<WORKSPACEID, HTThumbnail> thumbnails;
+};
+
+// Offscreen copy of a single window (with its decorations), at the window's pixel size, in
+// the corner of a monitor-sized framebuffer.
+class HTWindowSnapshot {
+  public:
+    // Snapshot `window` on the next refresh. Safe to call outside the render pass.
+    void request(PHLWINDOW window);
+    // Render `window` into the snapshot. Begins its own render, like HTThumbnailCache::refresh.
+    void capture(PHLWINDOW window);
+    // Recapture on the next refresh, if the snapshot is of `window`
+    void damage(PHLWINDOW window);
+    // Recapture the window if it was damaged since the last capture
+    void refresh();
+    // Release the framebuffer and forget the window.
+    void clear();
+
+    // Texture of the snapshot of `window`, or null if there is none.
+    SP<Render::ITexture> texture(PHLWINDOW window);
+    // Box to draw the whole texture at so the window lands on `box`; clip to `box`.
+    CBox texture_box(const CBox& box) const;
+
+  private:
+    CFramebuffer fb;
+    // Of the window within fb, and of the monitor it was captured on (transformed pixels)
+    Vector2D size;
+    Vector2D monitor_size;
+    PHLWINDOWREF window;
+    bool dirty = true;
+};